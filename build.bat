@@ -58,6 +58,8 @@ set OBJ_DIR=%BUILD_DIR%\%BUILD_SUFFIX%\obj
 set BIN_DIR=%BUILD_DIR%\%BUILD_SUFFIX%\bin
 set EXECUTABLE=%BIN_DIR%\%PROJECT_NAME%.exe
 set GAME_LIBRARY=%BIN_DIR%\libgame%LIBRARY_EXT%
+set PAK_BUILDER=%BUILD_DIR%\%BUILD_SUFFIX%\pak_builder.exe
+set ASSET_PAK=%BIN_DIR%\assets.pak
 set MAIN_PDB=%BIN_DIR%\%PROJECT_NAME%.pdb
 set GAME_PDB=%BIN_DIR%\libgame.pdb
 
@@ -110,12 +112,21 @@ if %errorlevel% equ 0 (
     echo shadercross not found, skipping shader compilation
 )
 
-REM Copy assets
+REM Pack assets into a single archive the game maps at startup
 if exist "%ASSETS_DIR%" (
-    echo Copying assets...
-    xcopy /E /I /Y "%ASSETS_DIR%" "%BIN_DIR%\%ASSETS_DIR%\" >nul
+    echo Packing assets...
+    %CXX% %CXXFLAGS% -I%SRC_DIR% %SDL3_INCLUDE% "%SRC_DIR%\tools\pak_builder.cpp" -o "%PAK_BUILDER%" -fuse-ld=lld %SDL3_LIBS% %DL_LIBS%
+    if !errorlevel! neq 0 (
+        echo Error: Failed to compile pak_builder
+        exit /b 1
+    )
+    "%PAK_BUILDER%" "%ASSETS_DIR%" "%ASSET_PAK%"
+    if !errorlevel! neq 0 (
+        echo Error: Failed to pack assets
+        exit /b 1
+    )
 ) else (
-    echo Warning: %ASSETS_DIR% directory not found, skipping asset copy
+    echo Warning: %ASSETS_DIR% directory not found, skipping asset packing
 )
 
 REM Compile source files
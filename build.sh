@@ -57,6 +57,8 @@ OBJ_DIR="$BUILD_DIR/$BUILD_SUFFIX/obj"
 BIN_DIR="$BUILD_DIR/$BUILD_SUFFIX/bin"
 EXECUTABLE="$BIN_DIR/$PROJECT_NAME"
 GAME_LIBRARY="$BIN_DIR/libgame$LIBRARY_EXT"
+PAK_BUILDER="$BUILD_DIR/$BUILD_SUFFIX/pak_builder"
+ASSET_PAK="$BIN_DIR/assets.pak"
 
 echo "Building in $BUILD_SUFFIX mode..."
 
@@ -104,12 +106,13 @@ else
     fi
 fi
 
-# Copy assets
+# Pack assets into a single archive the game maps at startup
 if [[ -d "$ASSETS_DIR" ]]; then
-    echo "Copying assets..."
-    cp -r "$ASSETS_DIR" "$BIN_DIR/"
+    echo "Packing assets..."
+    $CXX $CXXFLAGS -I$SRC_DIR $SDL3_INCLUDE "$SRC_DIR/tools/pak_builder.cpp" -o "$PAK_BUILDER" $SDL3_LIBS
+    "$PAK_BUILDER" "$ASSETS_DIR" "$ASSET_PAK"
 else
-    echo "Warning: $ASSETS_DIR directory not found, skipping asset copy"
+    echo "Warning: $ASSETS_DIR directory not found, skipping asset packing"
 fi
 
 # Compile source files
@@ -1,5 +1,6 @@
 #include "core/arena.h"
 #include "core/assert.h"
+#include "core/virtual_memory.h"
 
 #include <SDL3/SDL.h>
 #include <string.h> // For std::memset
@@ -14,13 +15,24 @@ inline void* align_ptr(void* ptr, usize alignment) {
     return (void*)(aligned_addr);
 }
 
-Arena::Arena(usize initial_block_capacity, bool can_grow)
-    : can_grow(can_grow), current_block(nullptr), total_used_size(0),
-      initial_block_capacity(initial_block_capacity) {
+// Helper for rounding sizes up to a power of two multiple
+inline usize align_size(usize size, usize alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+Arena::Arena(usize initial_block_capacity, bool can_grow, ArenaBackend backend)
+    : can_grow(can_grow), backend(backend), current_block(nullptr),
+      total_used_size(0), initial_block_capacity(initial_block_capacity),
+      decommit_threshold(0), stats(), current_tag(0) {
+#ifdef DEBUG
+    temp_depth = 0;
+#endif
     DEBUG_ASSERT(
         initial_block_capacity != 0,
         "Initial block capacity cannot be zero."
     );
+    // Slot 0 collects untagged pushes
+    stats.tag_count = 1;
     grow_arena(initial_block_capacity);
 }
 
@@ -33,8 +45,7 @@ void Arena::destroy() {
         ArenaBlock* prev_block = current;
         current = current->next; // Move to the next block in the chain
                                  // (towards head)
-        SDL_free(prev_block->memory);
-        SDL_free(prev_block);
+        release_block(prev_block);
     }
     current_block = nullptr;
 }
@@ -72,7 +83,19 @@ void* Arena::push(usize size, usize alignment) {
             initial_block_capacity,
             size + alignment - 1
         ); // Ensure new block can fit 'size' after alignment
-        grow_arena(new_block_capacity);
+        usize abandoned_tail = current_block->capacity - current_block->used;
+        if (!grow_arena(new_block_capacity)) {
+            return nullptr;
+        }
+        stats.grow_count++;
+        stats.tail_waste += abandoned_tail;
+        SDL_Log(
+            "Arena overflowed at %zu bytes used, chained block #%zu of %zu "
+            "bytes",
+            total_used_size,
+            stats.block_count,
+            current_block->capacity
+        );
 
         // Recalculate aligned pointer for the new block
         aligned_ptr_in_block = (u8*)(align_ptr(
@@ -86,10 +109,24 @@ void* Arena::push(usize size, usize alignment) {
 
     // Allocate from the current block
     u8* allocated_ptr = aligned_ptr_in_block;
+    usize new_used = (allocated_ptr - current_block->memory) + size;
+
+    // Virtual blocks only have their touched prefix backed by memory
+    if (new_used > current_block->committed &&
+        !commit_block(current_block, new_used)) {
+        DEBUG_ASSERT(false, "Failed to commit arena memory.");
+        return nullptr;
+    }
+
     // Update used bytes
-    current_block->used = (allocated_ptr - current_block->memory) + size;
+    current_block->used = new_used;
     // Accumulate total logical size across blocks
     total_used_size += padded_size;
+
+    stats.alignment_waste += padded_size - size;
+    stats.peak_used = SDL_max(stats.peak_used, total_used_size);
+    stats.tags[current_tag].bytes += size;
+    stats.tags[current_tag].allocations++;
     return allocated_ptr;
 }
 
@@ -101,72 +138,172 @@ void* Arena::push_zero(usize size, usize alignment) {
     return ptr;
 }
 
-void Arena::pop(usize new_total_size) {
+bool Arena::extend(void* ptr, usize old_size, usize new_size) {
+    DEBUG_ASSERT(new_size >= old_size, "Extend cannot shrink an allocation.");
+
+    if (!current_block ||
+        (u8*)ptr + old_size != current_block->memory + current_block->used) {
+        return false;
+    }
+
+    usize delta = new_size - old_size;
+    usize new_used = current_block->used + delta;
+    if (new_used > current_block->capacity) {
+        return false;
+    }
+
+    if (new_used > current_block->committed &&
+        !commit_block(current_block, new_used)) {
+        return false;
+    }
+
+    current_block->used = new_used;
+    total_used_size += delta;
+
+    stats.peak_used = SDL_max(stats.peak_used, total_used_size);
+    stats.tags[current_tag].bytes += delta;
+    return true;
+}
+
+ArenaTemp Arena::begin_temp() {
+    ArenaTemp temp{};
+    temp.arena = this;
+    temp.block = current_block;
+    temp.block_used = current_block ? current_block->used : 0;
+    temp.total_used_size = total_used_size;
+#ifdef DEBUG
+    temp.depth = ++temp_depth;
+#endif
+    return temp;
+}
+
+void Arena::end_temp(ArenaTemp temp) {
+    DEBUG_ASSERT(temp.arena == this, "ArenaTemp ended on the wrong arena.");
+#ifdef DEBUG
     DEBUG_ASSERT(
-        new_total_size < total_used_size,
-        "Cannot pop to a position beyond current total used size."
+        temp.depth == temp_depth,
+        "ArenaTemp scopes must be ended in LIFO order."
     );
+    temp_depth--;
+#endif
 
-    if (new_total_size == total_used_size) {
-        return; // No change
+    // Release blocks chained after the checkpoint was taken
+    while (current_block != temp.block) {
+        DEBUG_ASSERT(
+            current_block != nullptr,
+            "ArenaTemp block is not part of this arena."
+        );
+        ArenaBlock* newer_block = current_block;
+        current_block = current_block->next;
+        release_block(newer_block);
     }
 
-    // Traverse blocks from newest to oldest to find the block containing
-    // new_total_size
-    usize remaining_size = new_total_size;
-    ArenaBlock* target_block = nullptr;
-
-    // Find the block that contains or comes after new_total_size
-    // We traverse *backwards* from current_block_ to logically reset
-    ArenaBlock* current = current_block;
-    while (current) {
-        if (remaining_size < current->used) {
-            target_block = current;
-            break;
-        }
-        remaining_size -= current->capacity; // Adjust for full blocks
-        current = current->next; // Move to the previous block (towards head
-                                 // of chain)
-    }
-
-    if (target_block) {
-        // Reset used portion of this block
-        target_block->used = remaining_size;
-        // All blocks newer than target_block are now logically empty (or
-        // completely unused for pop) For simplicity in this example, we
-        // just set their `used` to 0. In a more complex "stack-like" pop,
-        // you'd properly manage the `current_block_` pointer.
-        ArenaBlock* temp = current_block;
-        while (temp != target_block) {
-            temp->used = 0;
-            temp = temp->next;
-        }
-        current_block = target_block; // Update current_block_ to the block
-                                      // where new_total_size ends
-    } else {                          // new_total_size is 0 or less
-        clear();
+    if (current_block) {
+        current_block->used = temp.block_used;
     }
-    total_used_size = new_total_size;
+    total_used_size = temp.total_used_size;
+}
+
+void Arena::keep_temp(ArenaTemp temp) {
+    DEBUG_ASSERT(temp.arena == this, "ArenaTemp kept on the wrong arena.");
+#ifdef DEBUG
+    DEBUG_ASSERT(
+        temp.depth == temp_depth,
+        "ArenaTemp scopes must be ended in LIFO order."
+    );
+    temp_depth--;
+#else
+    (void)temp;
+#endif
 }
 
 void Arena::clear() {
     if (current_block) {
-        // Reset used space for all blocks
-        ArenaBlock* current = current_block;
-        while (current) {
-            current->used = 0;
-            current = current->next;
+        // Release every block chained on growth, keeping only the first one
+        while (current_block->next) {
+            ArenaBlock* newer_block = current_block;
+            current_block = current_block->next;
+            release_block(newer_block);
         }
-        // Point to the first block for new allocations
-        current_block = get_first_block();
+        current_block->used = 0;
         total_used_size = 0;
+
+        // Give pages touched by a spike back to the OS
+        if (backend != ARENA_BACKEND_MALLOC && decommit_threshold != 0 &&
+            current_block->committed > decommit_threshold) {
+            usize keep = SDL_min(
+                align_size(decommit_threshold, current_block->commit_size),
+                current_block->committed
+            );
+            vm_decommit(
+                current_block->memory + keep,
+                current_block->committed - keep
+            );
+            stats.committed -= current_block->committed - keep;
+            current_block->committed = keep;
+        }
     }
 }
 
+void Arena::set_decommit_threshold(usize size) {
+    decommit_threshold = size;
+}
+
 usize Arena::get_total_used_size() {
     return total_used_size;
 }
 
+void Arena::set_tag(const char* tag) {
+    if (!tag) {
+        current_tag = 0;
+        return;
+    }
+
+    for (usize i = 1; i < stats.tag_count; i++) {
+        if (stats.tags[i].tag == tag ||
+            SDL_strcmp(stats.tags[i].tag, tag) == 0) {
+            current_tag = i;
+            return;
+        }
+    }
+
+    if (stats.tag_count == ARENA_MAX_TAGS) {
+        SDL_Log("Arena tag table is full, accounting '%s' as untagged", tag);
+        current_tag = 0;
+        return;
+    }
+
+    current_tag = stats.tag_count++;
+    stats.tags[current_tag].tag = tag;
+}
+
+const ArenaStats& Arena::get_stats() const {
+    return stats;
+}
+
+void Arena::log_stats(const char* name) const {
+    SDL_Log("Arena '%s':", name);
+    SDL_Log("  used:            %zu", total_used_size);
+    SDL_Log("  peak used:       %zu", stats.peak_used);
+    SDL_Log("  reserved:        %zu", stats.reserved);
+    SDL_Log("  committed:       %zu", stats.committed);
+    SDL_Log("  backing:         %s", vm_page_backing_name(stats.page_backing));
+    SDL_Log("  blocks:          %zu", stats.block_count);
+    SDL_Log("  overflow grows:  %zu", stats.grow_count);
+    SDL_Log("  alignment waste: %zu", stats.alignment_waste);
+    SDL_Log("  tail waste:      %zu", stats.tail_waste);
+    for (usize i = 0; i < stats.tag_count; i++) {
+        const ArenaTagStats& tag = stats.tags[i];
+        if (tag.allocations == 0) continue;
+        SDL_Log(
+            "  [%s] %zu bytes in %zu allocations",
+            tag.tag ? tag.tag : "untagged",
+            tag.bytes,
+            tag.allocations
+        );
+    }
+}
+
 template <typename T> T* Arena::push_array(usize count, usize alignment) {
     return (T*)(push(sizeof(T) * count, alignment));
 }
@@ -177,7 +314,9 @@ template <typename T> T* Arena::push_array_zero(usize count, usize alignment) {
 
 template <typename T> T* Arena::push_struct(usize alignment) {
     void* memory = push(sizeof(T), alignment);
-    return new (memory) T(); // Constructs T in uninitialized memory
+    // Default-init rather than value-init: T() would zero the whole struct
+    // first, faulting in every page of large members such as FixedArray
+    return new (memory) T;
 }
 
 template <typename T> T* Arena::push_struct_zero(usize alignment) {
@@ -185,27 +324,90 @@ template <typename T> T* Arena::push_struct_zero(usize alignment) {
     return new (memory) T(); // Constructs T in zeroed memory
 }
 
-void Arena::grow_arena(usize min_capacity) {
+bool Arena::grow_arena(usize min_capacity) {
     usize actual_capacity = SDL_max(min_capacity, initial_block_capacity);
 
     // Allocate metadata for the new block
     ArenaBlock* new_block = (ArenaBlock*)SDL_malloc(sizeof(ArenaBlock));
+    if (!new_block) {
+        return false;
+    }
+
     // Allocate raw memory
-    new_block->memory = (u8*)SDL_malloc(actual_capacity);
+    VmPageBacking backing = VM_PAGES_SMALL;
+    usize small_commit_size = SDL_max(ARENA_COMMIT_SIZE, vm_page_size());
+    if (backend == ARENA_BACKEND_HUGE_PAGES || backend == ARENA_BACKEND_EXPLICIT_HUGE_PAGES) {
+        actual_capacity = align_size(actual_capacity, VM_HUGE_PAGE_SIZE);
+        new_block->memory = (u8*)vm_reserve_huge(
+            actual_capacity,
+            backend == ARENA_BACKEND_EXPLICIT_HUGE_PAGES,
+            &backing
+        );
+        new_block->committed = 0;
+        new_block->commit_size =
+            backing == VM_PAGES_SMALL ? small_commit_size : VM_HUGE_PAGE_SIZE;
+        if (new_block->memory) {
+            SDL_Log(
+                "Arena reserved %zu bytes backed by %s",
+                actual_capacity,
+                vm_page_backing_name(backing)
+            );
+        }
+    } else if (backend == ARENA_BACKEND_VIRTUAL) {
+        new_block->commit_size = small_commit_size;
+        actual_capacity = align_size(actual_capacity, new_block->commit_size);
+        new_block->memory = (u8*)vm_reserve(actual_capacity);
+        new_block->committed = 0;
+    } else {
+        new_block->memory = (u8*)SDL_malloc(actual_capacity);
+        new_block->committed = actual_capacity;
+        new_block->commit_size = actual_capacity;
+    }
+
+    if (!new_block->memory) {
+        SDL_Log("Failed to allocate arena block of %zu bytes", actual_capacity);
+        SDL_free(new_block);
+        return false;
+    }
+
     new_block->capacity = actual_capacity;
     new_block->used = 0;
+    stats.block_count++;
+    stats.page_backing = backing;
+    stats.reserved += new_block->capacity;
+    stats.committed += new_block->committed;
     // Link new block to the previous
     // (making it the head)
     new_block->next = current_block;
     // New block becomes the current active block
     current_block = new_block;
+    return true;
 }
 
-ArenaBlock* Arena::get_first_block() {
-    ArenaBlock* current = current_block;
-    if (!current) return nullptr;
-    while (current->next) {
-        current = current->next;
+bool Arena::commit_block(ArenaBlock* block, usize size) {
+    usize new_committed = SDL_min(
+        align_size(size, block->commit_size),
+        block->capacity
+    );
+    if (!vm_commit(
+            block->memory + block->committed,
+            new_committed - block->committed
+        )) {
+        return false;
+    }
+    stats.committed += new_committed - block->committed;
+    block->committed = new_committed;
+    return true;
+}
+
+void Arena::release_block(ArenaBlock* block) {
+    stats.block_count--;
+    stats.reserved -= block->capacity;
+    stats.committed -= block->committed;
+    if (backend != ARENA_BACKEND_MALLOC) {
+        vm_release(block->memory, block->capacity);
+    } else {
+        SDL_free(block->memory);
     }
-    return current;
+    SDL_free(block);
 }
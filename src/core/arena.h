@@ -1,20 +1,86 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/virtual_memory.h"
+
+// Granularity used when committing pages of a virtual arena block
+#define ARENA_COMMIT_SIZE ((usize)64 * 1024)
+
+enum ArenaBackend {
+    // Each block is SDL_malloc'd up front
+    ARENA_BACKEND_MALLOC,
+    // Each block is a reserved address range whose pages are committed on
+    // demand as allocations advance through it
+    ARENA_BACKEND_VIRTUAL,
+    // Like ARENA_BACKEND_VIRTUAL, but blocks prefer 2 MB pages to cut TLB
+    // misses on large hot arenas. Falls back to small pages when huge pages
+    // are unavailable; ArenaStats::page_backing reports the outcome.
+    ARENA_BACKEND_HUGE_PAGES,
+    // Like ARENA_BACKEND_HUGE_PAGES, but tries the explicit hugetlbfs pool
+    // first. The pool is charged for whole blocks when they are reserved, so
+    // only use it for arenas whose capacity matches what they really use.
+    ARENA_BACKEND_EXPLICIT_HUGE_PAGES,
+};
 
 // Structure for a memory block in the arena chain
 struct ArenaBlock {
     u8* memory;       // Pointer to the allocated raw memory for this block
     usize capacity;   // Total capacity of this block
+    usize committed;  // Bytes backed by memory (== capacity for malloc blocks)
+    usize commit_size; // Granularity pages are committed in
     usize used;       // Currently used bytes in this block
     ArenaBlock* next; // Pointer to the next block in the chain
 };
 
+// Maximum number of distinct tags an arena accounts bytes for
+#define ARENA_MAX_TAGS 16
+
+struct ArenaTagStats {
+    const char* tag;   // Tag passed to Arena::set_tag, nullptr for untagged
+    usize bytes;       // Bytes pushed under this tag (cumulative)
+    usize allocations; // Number of pushes under this tag (cumulative)
+};
+
+// Counters maintained by every arena. Sizes are in bytes; "cumulative"
+// counters are never rewound by end_temp() or clear().
+struct ArenaStats {
+    usize peak_used;       // Highest `used` ever reached
+    usize reserved;        // Sum of the capacity of all live blocks
+    usize committed;       // Sum of the committed bytes of all live blocks
+    usize block_count;     // Number of live blocks
+    usize grow_count;      // Blocks chained because a push overflowed
+    usize alignment_waste; // Padding inserted to align pushes (cumulative)
+    usize tail_waste;      // Block tails abandoned on growth (cumulative)
+    VmPageBacking page_backing; // Pages backing the newest block
+    usize tag_count;
+    ArenaTagStats tags[ARENA_MAX_TAGS];
+};
+
+struct Arena;
+
+// Checkpoint of an arena's allocation position. Restoring it releases
+// everything pushed since it was taken. Checkpoints nest and must be ended
+// in the reverse order they were begun.
+struct ArenaTemp {
+    Arena* arena;
+    ArenaBlock* block; // Block that was current when the checkpoint was taken
+    usize block_used;  // Its used bytes at that time
+    usize total_used_size;
+#ifdef DEBUG
+    u32 depth; // Nesting depth, used to validate LIFO release
+#endif
+};
+
 struct Arena {
     // Constructor: Initializes the arena with an initial block capacity.
     // New blocks will be at least this size, or larger if a single allocation
-    // request exceeds it.
-    Arena(usize initial_block_capacity = 4096, bool can_grow = true);
+    // request exceeds it. With ARENA_BACKEND_VIRTUAL the capacity is only
+    // reserved address space; memory is committed as push() advances.
+    Arena(
+        usize initial_block_capacity = 4096,
+        bool can_grow = true,
+        ArenaBackend backend = ARENA_BACKEND_MALLOC
+    );
 
     // Destructor: Frees all memory blocks owned by the arena.
     void destroy();
@@ -26,18 +92,44 @@ struct Arena {
     // PushZero: Allocates 'size' bytes and initializes them to zero.
     void* push_zero(usize size, usize alignment = 8);
 
-    // Pop: Resets the total allocated size to `new_total_size`.
-    // Effectively deallocates all memory pushed after `new_total_size`.
-    // This is a "logical" pop; memory within blocks is only marked as unused.
-    void pop(usize new_total_size);
+    // Extend: Grows the allocation at `ptr` from `old_size` to `new_size` in
+    // place. Only possible when it is the most recent allocation and the
+    // current block has room; returns false otherwise.
+    bool extend(void* ptr, usize old_size, usize new_size);
+
+    // BeginTemp: Records the current allocation position.
+    ArenaTemp begin_temp();
+
+    // EndTemp: Rewinds the arena to `temp`, releasing any block that was
+    // chained since it was taken. Constant time when no block was chained.
+    void end_temp(ArenaTemp temp);
+
+    // KeepTemp: Closes `temp` without rewinding, keeping everything pushed
+    // since it was taken. For checkpoints that only guard a failure path.
+    void keep_temp(ArenaTemp temp);
 
     // ArenaClear: Resets the arena, making all its memory available for reuse.
-    // Does not free the underlying memory blocks to the OS.
+    // Blocks chained on growth are released; the first block is kept.
     void clear();
 
+    // SetDecommitThreshold: For virtual arenas, committed memory above
+    // `size` is returned to the OS on clear(), so a single spike does not
+    // keep its pages resident forever. 0 (the default) keeps everything.
+    void set_decommit_threshold(usize size);
+
     // Get current total allocated size across all blocks.
     usize get_total_used_size();
 
+    // SetTag: Accounts every following push to `tag` until the next call.
+    // Tags are compared by content; pass nullptr to go back to untagged.
+    void set_tag(const char* tag);
+
+    // GetStats: Returns the arena's instrumentation counters.
+    const ArenaStats& get_stats() const;
+
+    // LogStats: Dumps the counters and per-tag breakdown through SDL_Log.
+    void log_stats(const char* name) const;
+
     // Helper macro for C-style convenience
     template <typename T>
     T* push_array(usize count, usize alignment = alignof(T));
@@ -45,22 +137,37 @@ struct Arena {
     template <typename T>
     T* push_array_zero(usize count, usize alignment = alignof(T));
 
+    // PushStruct: Default-initializes T, so only members with initializers
+    // are written and the rest of the memory is left untouched.
     template <typename T> T* push_struct(usize alignment = alignof(T));
 
     template <typename T> T* push_struct_zero(usize alignment = alignof(T));
 
   private:
     bool can_grow;
+    ArenaBackend backend;
     // Pointer to the current active block for allocations*
     ArenaBlock* current_block;
     // Accumulative logical size of all allocations
     usize total_used_size;
     // Default capacity for new blocks
     usize initial_block_capacity;
+    // Committed bytes kept per block on clear() (virtual backend only)
+    usize decommit_threshold;
+    // Instrumentation counters and the tag slot pushes are accounted to
+    ArenaStats stats;
+    usize current_tag;
+#ifdef DEBUG
+    // Number of checkpoints currently open
+    u32 temp_depth;
+#endif
 
     // Internal function to allocate a new memory block and add it to the chain.
-    void grow_arena(usize min_capacity);
+    bool grow_arena(usize min_capacity);
+
+    // Commits pages of a virtual block so that `size` bytes are accessible.
+    bool commit_block(ArenaBlock* block, usize size);
 
-    // Helper to get the very first block in the chain (oldest block)
-    ArenaBlock* get_first_block();
+    // Returns a block's memory and metadata to the OS.
+    void release_block(ArenaBlock* block);
 };
@@ -0,0 +1,756 @@
+#include "core/async_io.h"
+#include "core/assert.h"
+#include "core/scratch.h"
+
+#include <SDL3/SDL.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ASYNC_IO_URING
+#endif
+
+// Largest single read or write handed to the kernel; longer transfers are
+// continued from where the previous one stopped
+#define ASYNC_IO_MAX_TRANSFER ((usize)1 << 30)
+
+enum AsyncIoStage {
+    ASYNC_IO_STAGE_OPEN,
+    ASYNC_IO_STAGE_TRANSFER,
+    ASYNC_IO_STAGE_CLOSE,
+    ASYNC_IO_STAGE_STAT,
+};
+
+struct AsyncIoSlot {
+    char path[ASYNC_IO_MAX_PATH];
+    u8* buffer;
+    usize size;
+    u64 offset;
+    AsyncIoCompletion result;
+#if defined(ASYNC_IO_URING)
+    AsyncIoStage stage;
+    i32 fd;
+    struct statx stx;
+#endif
+};
+
+static const char* async_io_op_name(AsyncIoOp op) {
+    switch (op) {
+        case ASYNC_IO_READ:
+            return "read";
+        case ASYNC_IO_WRITE:
+            return "write";
+        case ASYNC_IO_STAT:
+            return "stat";
+    }
+    return "unknown";
+}
+
+#if defined(ASYNC_IO_URING)
+// io_uring through raw syscalls, so there is no liburing dependency
+
+struct AsyncIoUring {
+    i32 fd;
+    u32 sq_entries;
+    u8* sq_ring;
+    usize sq_ring_size;
+    u8* cq_ring;
+    usize cq_ring_size;
+    io_uring_sqe* sqes;
+    usize sqes_size;
+
+    u32* sq_head;
+    u32* sq_tail;
+    u32* sq_array;
+    u32 sq_mask;
+    u32* cq_head;
+    u32* cq_tail;
+    u32 cq_mask;
+    io_uring_cqe* cqes;
+
+    u32 to_submit; // Entries queued in the SQ ring but not yet submitted
+};
+
+/**
+ * @brief Checks that the kernel supports every opcode the backend uses.
+ *
+ * Kernels before 5.6 have io_uring but not OPENAT/CLOSE/STATX; the thread
+ * backend is used there instead.
+ */
+static bool uring_supports_ops(i32 ring_fd, Arena* arena) {
+    Scratch scratch = get_scratch(arena);
+    usize probe_size = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    io_uring_probe* probe = (io_uring_probe*)scratch.arena->push_zero(probe_size);
+    if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+        return false;
+    }
+
+    const u8 required[] = {
+        IORING_OP_OPENAT,
+        IORING_OP_READ,
+        IORING_OP_WRITE,
+        IORING_OP_CLOSE,
+        IORING_OP_STATX,
+    };
+    for (u8 op : required) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void uring_destroy(AsyncIoUring* ring) {
+    if (ring->sqes) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    if (ring->sq_ring) munmap(ring->sq_ring, ring->sq_ring_size);
+    if (ring->fd >= 0) close(ring->fd);
+    *ring = {};
+    ring->fd = -1;
+}
+
+/**
+ * @brief Sets up an io_uring instance and maps its rings.
+ * @param ring Receives the ring.
+ * @param entries Submission queue size, at least the number of slots.
+ * @param arena Arena the backend's own memory comes from.
+ * @return False if io_uring is missing, forbidden or too old.
+ */
+static bool uring_create(AsyncIoUring* ring, u32 entries, Arena* arena) {
+    *ring = {};
+    ring->fd = -1;
+
+    io_uring_params params{};
+    i32 fd = (i32)syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        SDL_Log("io_uring unavailable (%s)", strerror(errno));
+        return false;
+    }
+    ring->fd = fd;
+
+    if (!uring_supports_ops(fd, arena)) {
+        SDL_Log("io_uring lacks the required opcodes");
+        uring_destroy(ring);
+        return false;
+    }
+
+    ring->sq_entries = params.sq_entries;
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        ring->sq_ring_size = SDL_max(ring->sq_ring_size, ring->cq_ring_size);
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    void* sq_ring = mmap(
+        nullptr,
+        ring->sq_ring_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_SQ_RING
+    );
+    if (sq_ring == MAP_FAILED) {
+        SDL_Log("Failed to map io_uring SQ ring: %s", strerror(errno));
+        uring_destroy(ring);
+        return false;
+    }
+    ring->sq_ring = (u8*)sq_ring;
+
+    if (single_mmap) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        void* cq_ring = mmap(
+            nullptr,
+            ring->cq_ring_size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            fd,
+            IORING_OFF_CQ_RING
+        );
+        if (cq_ring == MAP_FAILED) {
+            SDL_Log("Failed to map io_uring CQ ring: %s", strerror(errno));
+            uring_destroy(ring);
+            return false;
+        }
+        ring->cq_ring = (u8*)cq_ring;
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(
+        nullptr,
+        ring->sqes_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_SQES
+    );
+    if (sqes == MAP_FAILED) {
+        SDL_Log("Failed to map io_uring SQEs: %s", strerror(errno));
+        uring_destroy(ring);
+        return false;
+    }
+    ring->sqes = (io_uring_sqe*)sqes;
+
+    ring->sq_head = (u32*)(ring->sq_ring + params.sq_off.head);
+    ring->sq_tail = (u32*)(ring->sq_ring + params.sq_off.tail);
+    ring->sq_array = (u32*)(ring->sq_ring + params.sq_off.array);
+    ring->sq_mask = *(u32*)(ring->sq_ring + params.sq_off.ring_mask);
+    ring->cq_head = (u32*)(ring->cq_ring + params.cq_off.head);
+    ring->cq_tail = (u32*)(ring->cq_ring + params.cq_off.tail);
+    ring->cq_mask = *(u32*)(ring->cq_ring + params.cq_off.ring_mask);
+    ring->cqes = (io_uring_cqe*)(ring->cq_ring + params.cq_off.cqes);
+    return true;
+}
+
+/**
+ * @brief Queues a submission entry; it reaches the kernel on the next
+ * uring_enter.
+ *
+ * Every slot has at most one entry queued or in flight and the SQ ring has
+ * at least as many entries as there are slots, so it cannot overflow.
+ */
+static void uring_push(AsyncIoUring* ring, const io_uring_sqe& sqe) {
+    u32 tail = *ring->sq_tail;
+    DEBUG_ASSERT(
+        tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) < ring->sq_entries,
+        "io_uring submission queue overflow"
+    );
+    u32 index = tail & ring->sq_mask;
+    ring->sqes[index] = sqe;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->to_submit++;
+}
+
+/**
+ * @brief Submits queued entries and optionally waits for a completion.
+ */
+static void uring_enter(AsyncIoUring* ring, bool wait) {
+    if (ring->to_submit == 0 && !wait) return;
+
+    u32 flags = wait ? IORING_ENTER_GETEVENTS : 0;
+    for (;;) {
+        i64 submitted = syscall(
+            __NR_io_uring_enter,
+            ring->fd,
+            ring->to_submit,
+            wait ? 1 : 0,
+            flags,
+            nullptr,
+            0
+        );
+        if (submitted >= 0) {
+            ring->to_submit -= (u32)submitted;
+            return;
+        }
+        if (errno != EINTR) {
+            // EAGAIN/EBUSY: the kernel is short on resources; the entries
+            // stay queued and go out with the next call
+            if (errno != EAGAIN && errno != EBUSY) {
+                SDL_Log("io_uring_enter failed: %s", strerror(errno));
+            }
+            return;
+        }
+    }
+}
+
+static void uring_push_open(AsyncIoUring* ring, AsyncIoSlot* slot, u32 slot_index) {
+    io_uring_sqe sqe{};
+    sqe.opcode = IORING_OP_OPENAT;
+    sqe.fd = AT_FDCWD;
+    sqe.addr = (u64)slot->path;
+    if (slot->result.op == ASYNC_IO_WRITE) {
+        sqe.open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+        sqe.len = 0666;
+    } else {
+        sqe.open_flags = O_RDONLY | O_CLOEXEC;
+    }
+    sqe.user_data = slot_index;
+    uring_push(ring, sqe);
+}
+
+static void uring_push_transfer(AsyncIoUring* ring, AsyncIoSlot* slot, u32 slot_index) {
+    usize done = slot->result.bytes;
+    io_uring_sqe sqe{};
+    sqe.opcode = slot->result.op == ASYNC_IO_WRITE ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe.fd = slot->fd;
+    sqe.addr = (u64)(slot->buffer + done);
+    sqe.len = (u32)SDL_min(slot->size - done, ASYNC_IO_MAX_TRANSFER);
+    sqe.off = slot->offset + done;
+    sqe.user_data = slot_index;
+    uring_push(ring, sqe);
+}
+
+static void uring_push_close(AsyncIoUring* ring, AsyncIoSlot* slot, u32 slot_index) {
+    io_uring_sqe sqe{};
+    sqe.opcode = IORING_OP_CLOSE;
+    sqe.fd = slot->fd;
+    sqe.user_data = slot_index;
+    uring_push(ring, sqe);
+}
+
+static void uring_push_stat(AsyncIoUring* ring, AsyncIoSlot* slot, u32 slot_index) {
+    io_uring_sqe sqe{};
+    sqe.opcode = IORING_OP_STATX;
+    sqe.fd = AT_FDCWD;
+    sqe.addr = (u64)slot->path;
+    sqe.len = STATX_SIZE | STATX_MTIME;
+    sqe.off = (u64)&slot->stx;
+    sqe.user_data = slot_index;
+    uring_push(ring, sqe);
+}
+
+/**
+ * @brief Moves a request to its next stage after one of its operations
+ * completed: open, then read/write until done, then close.
+ * @param res The completion result (a byte count, fd, or -errno).
+ * @return True once the request is finished and its result is final.
+ */
+static bool uring_advance(AsyncIoUring* ring, AsyncIoSlot* slot, u32 slot_index, i32 res) {
+    AsyncIoCompletion* result = &slot->result;
+
+    switch (slot->stage) {
+        case ASYNC_IO_STAGE_OPEN:
+            if (res < 0) {
+                SDL_Log("Async %s of '%s' failed: %s", async_io_op_name(result->op), slot->path, strerror(-res));
+                return true;
+            }
+            slot->fd = res;
+            if (slot->size == 0) {
+                result->ok = true;
+                slot->stage = ASYNC_IO_STAGE_CLOSE;
+                uring_push_close(ring, slot, slot_index);
+                return false;
+            }
+            slot->stage = ASYNC_IO_STAGE_TRANSFER;
+            uring_push_transfer(ring, slot, slot_index);
+            return false;
+
+        case ASYNC_IO_STAGE_TRANSFER:
+            if (res < 0) {
+                SDL_Log("Async %s of '%s' failed: %s", async_io_op_name(result->op), slot->path, strerror(-res));
+            } else {
+                result->bytes += (usize)res;
+                if (res > 0 && result->bytes < slot->size) {
+                    uring_push_transfer(ring, slot, slot_index);
+                    return false;
+                }
+                // A read may stop early at end of file; a write may not
+                result->ok = result->op == ASYNC_IO_READ || result->bytes == slot->size;
+            }
+            slot->stage = ASYNC_IO_STAGE_CLOSE;
+            uring_push_close(ring, slot, slot_index);
+            return false;
+
+        case ASYNC_IO_STAGE_CLOSE:
+            // A failed close can lose buffered write errors
+            if (res < 0 && result->op == ASYNC_IO_WRITE) {
+                result->ok = false;
+            }
+            return true;
+
+        case ASYNC_IO_STAGE_STAT:
+            if (res < 0) {
+                SDL_Log("Async stat of '%s' failed: %s", slot->path, strerror(-res));
+                return true;
+            }
+            result->ok = true;
+            result->file_size = slot->stx.stx_size;
+            result->modify_time = (u64)slot->stx.stx_mtime.tv_sec * 1000000000ull +
+                                  slot->stx.stx_mtime.tv_nsec;
+            return true;
+    }
+    return true;
+}
+#endif
+
+// Worker thread fallback
+
+struct AsyncIoThreads {
+    SDL_Mutex* mutex;
+    SDL_Condition* work_ready;
+    SDL_Condition* done_ready;
+    AsyncIoSlot* slots;
+    u32 capacity;
+
+    // Rings of slot indices, each large enough for every slot
+    u32* pending;
+    u32 pending_head;
+    u32 pending_count;
+    u32* done;
+    u32 done_head;
+    u32 done_count;
+
+    SDL_Thread* workers[ASYNC_IO_MAX_WORKERS];
+    u32 worker_count;
+    bool quitting;
+};
+
+/**
+ * @brief Runs one request with blocking SDL file calls on a worker thread.
+ */
+static void async_io_run_blocking(AsyncIoSlot* slot) {
+    AsyncIoCompletion* result = &slot->result;
+
+    if (result->op == ASYNC_IO_STAT) {
+        SDL_PathInfo info{};
+        if (!SDL_GetPathInfo(slot->path, &info)) {
+            SDL_Log("Async stat of '%s' failed: %s", slot->path, SDL_GetError());
+            return;
+        }
+        result->ok = true;
+        result->file_size = info.size;
+        result->modify_time = (u64)info.modify_time;
+        return;
+    }
+
+    bool writing = result->op == ASYNC_IO_WRITE;
+    SDL_IOStream* file = SDL_IOFromFile(slot->path, writing ? "wb" : "rb");
+    if (!file) {
+        SDL_Log("Async %s of '%s' failed: %s", async_io_op_name(result->op), slot->path, SDL_GetError());
+        return;
+    }
+
+    if (writing) {
+        result->bytes = SDL_WriteIO(file, slot->buffer, slot->size);
+        result->ok = result->bytes == slot->size;
+    } else if (slot->offset == 0 || SDL_SeekIO(file, (Sint64)slot->offset, SDL_IO_SEEK_SET) >= 0) {
+        // SDL_ReadIO may return less than asked before the end of the file
+        while (result->bytes < slot->size) {
+            usize n = SDL_ReadIO(file, slot->buffer + result->bytes, slot->size - result->bytes);
+            if (n == 0) break;
+            result->bytes += n;
+        }
+        result->ok = true;
+    }
+
+    if (!SDL_CloseIO(file) && writing) {
+        result->ok = false;
+    }
+    if (!result->ok) {
+        SDL_Log("Async %s of '%s' failed: %s", async_io_op_name(result->op), slot->path, SDL_GetError());
+    }
+}
+
+static int async_io_worker(void* data) {
+    AsyncIoThreads* threads = (AsyncIoThreads*)data;
+
+    SDL_LockMutex(threads->mutex);
+    for (;;) {
+        while (threads->pending_count == 0 && !threads->quitting) {
+            SDL_WaitCondition(threads->work_ready, threads->mutex);
+        }
+        // Pending requests are still run when quitting, so no caller buffer
+        // is written after shutdown returns
+        if (threads->pending_count == 0) break;
+
+        u32 index = threads->pending[threads->pending_head];
+        threads->pending_head = (threads->pending_head + 1) % threads->capacity;
+        threads->pending_count--;
+        SDL_UnlockMutex(threads->mutex);
+
+        async_io_run_blocking(&threads->slots[index]);
+
+        SDL_LockMutex(threads->mutex);
+        u32 tail = (threads->done_head + threads->done_count) % threads->capacity;
+        threads->done[tail] = index;
+        threads->done_count++;
+        SDL_SignalCondition(threads->done_ready);
+    }
+    SDL_UnlockMutex(threads->mutex);
+    return 0;
+}
+
+static void async_io_threads_destroy(AsyncIoThreads* threads) {
+    if (threads->mutex) {
+        SDL_LockMutex(threads->mutex);
+        threads->quitting = true;
+        SDL_BroadcastCondition(threads->work_ready);
+        SDL_UnlockMutex(threads->mutex);
+    }
+    for (u32 i = 0; i < threads->worker_count; i++) {
+        SDL_WaitThread(threads->workers[i], nullptr);
+    }
+    threads->worker_count = 0;
+
+    if (threads->done_ready) SDL_DestroyCondition(threads->done_ready);
+    if (threads->work_ready) SDL_DestroyCondition(threads->work_ready);
+    if (threads->mutex) SDL_DestroyMutex(threads->mutex);
+    threads->done_ready = nullptr;
+    threads->work_ready = nullptr;
+    threads->mutex = nullptr;
+}
+
+static bool async_io_threads_create(
+    AsyncIoThreads* threads,
+    AsyncIoSlot* slots,
+    u32 capacity,
+    u32 worker_count,
+    Arena* arena
+) {
+    threads->slots = slots;
+    threads->capacity = capacity;
+    threads->pending = arena->push_array<u32>(capacity);
+    threads->done = arena->push_array<u32>(capacity);
+    threads->mutex = SDL_CreateMutex();
+    threads->work_ready = SDL_CreateCondition();
+    threads->done_ready = SDL_CreateCondition();
+    if (!threads->pending || !threads->done || !threads->mutex ||
+        !threads->work_ready || !threads->done_ready) {
+        SDL_Log("Failed to create async I/O queues: %s", SDL_GetError());
+        async_io_threads_destroy(threads);
+        return false;
+    }
+
+    worker_count = SDL_max(1u, SDL_min(worker_count, (u32)ASYNC_IO_MAX_WORKERS));
+    for (u32 i = 0; i < worker_count; i++) {
+        SDL_Thread* worker = SDL_CreateThread(async_io_worker, "async_io", threads);
+        if (!worker) {
+            SDL_Log("Failed to create async I/O worker: %s", SDL_GetError());
+            async_io_threads_destroy(threads);
+            return false;
+        }
+        threads->workers[threads->worker_count++] = worker;
+    }
+    return true;
+}
+
+bool AsyncIo::init(Arena* arena, u32 max_in_flight, u32 worker_count) {
+    DEBUG_ASSERT(max_in_flight > 0, "AsyncIo needs room for at least one request");
+
+    backend = ASYNC_IO_BACKEND_NONE;
+    uring = nullptr;
+    threads = nullptr;
+    slot_count = max_in_flight;
+    slots = arena->push_array_zero<AsyncIoSlot>(slot_count);
+    free_slots = arena->push_array<u32>(slot_count);
+    if (!slots || !free_slots) {
+        SDL_Log("Failed to allocate %u async I/O slots", slot_count);
+        return false;
+    }
+    // Stacked so slot 0 is handed out first
+    for (u32 i = 0; i < slot_count; i++) {
+        free_slots[i] = slot_count - 1 - i;
+    }
+    free_count = slot_count;
+
+#if defined(ASYNC_IO_URING)
+    uring = arena->push_struct_zero<AsyncIoUring>();
+    if (uring && uring_create(uring, slot_count, arena)) {
+        backend = ASYNC_IO_BACKEND_IO_URING;
+        SDL_Log("Async I/O backend: %s", backend_name());
+        return true;
+    }
+    uring = nullptr;
+#endif
+
+    threads = arena->push_struct_zero<AsyncIoThreads>();
+    if (!threads || !async_io_threads_create(threads, slots, slot_count, worker_count, arena)) {
+        threads = nullptr;
+        return false;
+    }
+    backend = ASYNC_IO_BACKEND_THREADS;
+    SDL_Log("Async I/O backend: %s", backend_name());
+    return true;
+}
+
+void AsyncIo::shutdown() {
+#if defined(ASYNC_IO_URING)
+    if (uring) {
+        // The kernel may still write into caller buffers, so drain first
+        AsyncIoCompletion discarded[16];
+        while (in_flight() > 0) {
+            collect(discarded, SDL_arraysize(discarded), true);
+        }
+        uring_destroy(uring);
+        uring = nullptr;
+    }
+#endif
+    if (threads) {
+        async_io_threads_destroy(threads);
+        threads = nullptr;
+        free_count = slot_count;
+    }
+    backend = ASYNC_IO_BACKEND_NONE;
+}
+
+/**
+ * @brief Takes a free slot and fills in the parts every request shares.
+ * @return The slot, or nullptr if every slot is in flight or the path is
+ * too long.
+ */
+AsyncIoSlot* AsyncIo::acquire_slot(AsyncIoOp op, const char* path, u64 user_data) {
+    DEBUG_ASSERT(backend != ASYNC_IO_BACKEND_NONE, "AsyncIo used before init");
+    if (free_count == 0) {
+        return nullptr;
+    }
+    if (SDL_strlen(path) >= ASYNC_IO_MAX_PATH) {
+        SDL_Log("Async I/O path too long: '%s'", path);
+        return nullptr;
+    }
+
+    AsyncIoSlot* slot = &slots[free_slots[--free_count]];
+    SDL_strlcpy(slot->path, path, sizeof(slot->path));
+    slot->buffer = nullptr;
+    slot->size = 0;
+    slot->offset = 0;
+    slot->result = {};
+    slot->result.op = op;
+    slot->result.user_data = user_data;
+    return slot;
+}
+
+void AsyncIo::release_slot(AsyncIoSlot* slot) {
+    free_slots[free_count++] = (u32)(slot - slots);
+}
+
+/**
+ * @brief Hands a filled slot to the backend.
+ */
+void AsyncIo::dispatch(AsyncIoSlot* slot) {
+    u32 index = (u32)(slot - slots);
+
+#if defined(ASYNC_IO_URING)
+    if (uring) {
+        if (slot->result.op == ASYNC_IO_STAT) {
+            slot->stage = ASYNC_IO_STAGE_STAT;
+            uring_push_stat(uring, slot, index);
+        } else {
+            slot->stage = ASYNC_IO_STAGE_OPEN;
+            slot->fd = -1;
+            uring_push_open(uring, slot, index);
+        }
+        uring_enter(uring, false);
+        return;
+    }
+#endif
+
+    SDL_LockMutex(threads->mutex);
+    u32 tail = (threads->pending_head + threads->pending_count) % threads->capacity;
+    threads->pending[tail] = index;
+    threads->pending_count++;
+    SDL_SignalCondition(threads->work_ready);
+    SDL_UnlockMutex(threads->mutex);
+}
+
+bool AsyncIo::read(const char* path, void* buffer, usize size, u64 offset, u64 user_data) {
+    AsyncIoSlot* slot = acquire_slot(ASYNC_IO_READ, path, user_data);
+    if (!slot) return false;
+
+    slot->buffer = (u8*)buffer;
+    slot->size = size;
+    slot->offset = offset;
+    dispatch(slot);
+    return true;
+}
+
+bool AsyncIo::write(const char* path, const void* data, usize size, u64 user_data) {
+    AsyncIoSlot* slot = acquire_slot(ASYNC_IO_WRITE, path, user_data);
+    if (!slot) return false;
+
+    slot->buffer = (u8*)data;
+    slot->size = size;
+    dispatch(slot);
+    return true;
+}
+
+bool AsyncIo::stat(const char* path, u64 user_data) {
+    AsyncIoSlot* slot = acquire_slot(ASYNC_IO_STAT, path, user_data);
+    if (!slot) return false;
+
+    dispatch(slot);
+    return true;
+}
+
+/**
+ * @brief Gathers finished requests into `out` and frees their slots.
+ * @param block Wait until at least one request finishes, unless none is in
+ * flight.
+ * @return The number of completions written.
+ */
+usize AsyncIo::collect(AsyncIoCompletion* out, usize max_count, bool block) {
+    usize count = 0;
+
+#if defined(ASYNC_IO_URING)
+    if (uring) {
+        for (;;) {
+            // A completion that does not finish its request queues the
+            // request's next stage instead
+            u32 head = *uring->cq_head;
+            u32 tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+            while (head != tail && count < max_count) {
+                io_uring_cqe* cqe = &uring->cqes[head & uring->cq_mask];
+                u32 index = (u32)cqe->user_data;
+                AsyncIoSlot* slot = &slots[index];
+                if (uring_advance(uring, slot, index, cqe->res)) {
+                    out[count++] = slot->result;
+                    release_slot(slot);
+                }
+                head++;
+            }
+            __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+
+            bool wait = block && count == 0 && in_flight() > 0;
+            uring_enter(uring, wait);
+            if (!wait) break;
+        }
+        return count;
+    }
+#endif
+
+    if (!threads) return 0;
+
+    SDL_LockMutex(threads->mutex);
+    if (block) {
+        while (threads->done_count == 0 && in_flight() > 0) {
+            SDL_WaitCondition(threads->done_ready, threads->mutex);
+        }
+    }
+    while (threads->done_count > 0 && count < max_count) {
+        u32 index = threads->done[threads->done_head];
+        threads->done_head = (threads->done_head + 1) % threads->capacity;
+        threads->done_count--;
+        out[count++] = slots[index].result;
+        release_slot(&slots[index]);
+    }
+    SDL_UnlockMutex(threads->mutex);
+    return count;
+}
+
+usize AsyncIo::poll(AsyncIoCompletion* out, usize max_count) {
+    return collect(out, max_count, false);
+}
+
+usize AsyncIo::wait(AsyncIoCompletion* out, usize max_count) {
+    return collect(out, max_count, true);
+}
+
+usize AsyncIo::in_flight() const {
+    return slot_count - free_count;
+}
+
+AsyncIoBackend AsyncIo::get_backend() const {
+    return backend;
+}
+
+const char* AsyncIo::backend_name() const {
+    switch (backend) {
+        case ASYNC_IO_BACKEND_IO_URING:
+            return "io_uring";
+        case ASYNC_IO_BACKEND_THREADS:
+            return "threads";
+        case ASYNC_IO_BACKEND_NONE:
+            return "none";
+    }
+    return "none";
+}
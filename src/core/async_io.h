@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+
+#define ASYNC_IO_MAX_PATH 512
+#define ASYNC_IO_MAX_WORKERS 8
+
+enum AsyncIoOp {
+    ASYNC_IO_READ,
+    ASYNC_IO_WRITE,
+    ASYNC_IO_STAT,
+};
+
+enum AsyncIoBackend {
+    ASYNC_IO_BACKEND_NONE,
+    ASYNC_IO_BACKEND_IO_URING,
+    ASYNC_IO_BACKEND_THREADS,
+};
+
+struct AsyncIoCompletion {
+    u64 user_data; // Passed through from the request
+    AsyncIoOp op;
+    bool ok;
+    usize bytes;     // Bytes read or written
+    u64 file_size;   // Stat only
+    u64 modify_time; // Stat only, same units as file_get_timestamp
+};
+
+struct AsyncIoSlot;
+struct AsyncIoUring;
+struct AsyncIoThreads;
+
+// Runs file reads, writes and stats off the frame thread. Linux uses
+// io_uring, so a request costs one non-blocking syscall to submit and the
+// kernel does the rest; elsewhere, or when io_uring is unavailable, a small
+// pool of worker threads runs the blocking calls.
+//
+// Finished requests wait in a completion queue until poll(), which the
+// frame loop calls once per frame. Buffers are owned by the caller
+// (typically pushed from an arena) and must stay valid until the matching
+// completion is polled. Submitting and polling must happen on one thread.
+struct AsyncIo {
+    // Init: `max_in_flight` bounds the requests outstanding at once; its
+    // bookkeeping is pushed from `arena`. Returns false on failure.
+    bool init(Arena* arena, u32 max_in_flight = 64, u32 worker_count = 2);
+    // Shutdown: Waits for outstanding requests and releases the backend.
+    void shutdown();
+
+    // Read: Reads up to `size` bytes at `offset` of `path` into `buffer`.
+    // Returns false if the queue is full.
+    bool read(const char* path, void* buffer, usize size, u64 offset, u64 user_data);
+    // Write: Replaces the contents of `path` (created if missing) with `data`
+    bool write(const char* path, const void* data, usize size, u64 user_data);
+    // Stat: Fetches the size and modification time of `path`
+    bool stat(const char* path, u64 user_data);
+
+    // Poll: Moves up to `max_count` finished requests into `out` without
+    // blocking and returns how many.
+    usize poll(AsyncIoCompletion* out, usize max_count);
+    // Wait: Like poll, but blocks until at least one request finishes.
+    // Returns 0 right away when nothing is in flight.
+    usize wait(AsyncIoCompletion* out, usize max_count);
+
+    usize in_flight() const;
+    AsyncIoBackend get_backend() const;
+    const char* backend_name() const;
+
+  private:
+    AsyncIoBackend backend{};
+    AsyncIoSlot* slots{};
+    u32 slot_count{};
+    u32* free_slots{}; // Stack of unused slot indices
+    u32 free_count{};
+    AsyncIoUring* uring{};
+    AsyncIoThreads* threads{};
+
+    AsyncIoSlot* acquire_slot(AsyncIoOp op, const char* path, u64 user_data);
+    void release_slot(AsyncIoSlot* slot);
+    void dispatch(AsyncIoSlot* slot);
+    usize collect(AsyncIoCompletion* out, usize max_count, bool block);
+};
@@ -0,0 +1,791 @@
+#include "core/batch2d.h"
+
+#include <SDL3/SDL.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#define BATCH2D_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+#define BATCH2D_AVX2_FN __attribute__((target("avx2")))
+#else
+#define BATCH2D_AVX2_FN
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BATCH2D_NEON
+#endif
+
+struct Batch2dKernels {
+    const char* name;
+    void (*transform_points)(const affine2&, const f32*, const f32*, f32*, f32*, usize);
+    void (*offset_scale_rects)(f32*, f32*, f32*, f32*, usize, vec2, vec2);
+    void (*lerp)(const f32*, const f32*, f32, f32*, usize);
+    void (*bounds)(const f32*, const f32*, usize, vec2*, vec2*);
+    usize (*rects_overlap)(const rect2&, const f32*, const f32*, const f32*, const f32*, usize, u32*);
+    usize (*rects_contain_point)(vec2, const f32*, const f32*, const f32*, const f32*, usize, u32*);
+    void (*rects_expand)(f32*, f32*, f32*, f32*, usize, vec2);
+};
+
+affine2 affine2::from_mat4x4(const mat4x4& m) {
+    return {m(0, 0), m(0, 1), m(0, 3), m(1, 0), m(1, 1), m(1, 3)};
+}
+
+// Scalar kernels, also used for the tails of the vector loops
+
+static void transform_points_scalar(
+    const affine2& xf,
+    const f32* xs,
+    const f32* ys,
+    f32* out_xs,
+    f32* out_ys,
+    usize count
+) {
+    for (usize i = 0; i < count; i++) {
+        f32 x = xs[i];
+        f32 y = ys[i];
+        out_xs[i] = xf.m00 * x + xf.m01 * y + xf.tx;
+        out_ys[i] = xf.m10 * x + xf.m11 * y + xf.ty;
+    }
+}
+
+static void offset_scale_rects_scalar(
+    f32* xs,
+    f32* ys,
+    f32* ws,
+    f32* hs,
+    usize count,
+    vec2 offset,
+    vec2 scale
+) {
+    for (usize i = 0; i < count; i++) {
+        xs[i] = xs[i] * scale.x + offset.x;
+        ys[i] = ys[i] * scale.y + offset.y;
+        ws[i] = ws[i] * scale.x;
+        hs[i] = hs[i] * scale.y;
+    }
+}
+
+static void lerp_scalar(const f32* a, const f32* b, f32 t, f32* out, usize count) {
+    for (usize i = 0; i < count; i++) {
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+static void bounds_scalar(
+    const f32* xs,
+    const f32* ys,
+    usize count,
+    vec2* min,
+    vec2* max
+) {
+    for (usize i = 0; i < count; i++) {
+        min->x = SDL_min(min->x, xs[i]);
+        min->y = SDL_min(min->y, ys[i]);
+        max->x = SDL_max(max->x, xs[i]);
+        max->y = SDL_max(max->y, ys[i]);
+    }
+}
+
+// The rect tests write every index and advance the output only on a hit, so
+// there is no branch to mispredict.
+
+static usize rects_overlap_scalar(
+    const rect2& r,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    usize hits = 0;
+    for (usize i = 0; i < count; i++) {
+        bool hit = (min_xs[i] < r.max.x) & (r.min.x < max_xs[i]) &
+                   (min_ys[i] < r.max.y) & (r.min.y < max_ys[i]);
+        out_indices[hits] = (u32)i;
+        hits += hit;
+    }
+    return hits;
+}
+
+static usize rects_contain_point_scalar(
+    vec2 p,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    usize hits = 0;
+    for (usize i = 0; i < count; i++) {
+        bool hit = (min_xs[i] <= p.x) & (p.x < max_xs[i]) &
+                   (min_ys[i] <= p.y) & (p.y < max_ys[i]);
+        out_indices[hits] = (u32)i;
+        hits += hit;
+    }
+    return hits;
+}
+
+static void rects_expand_scalar(
+    f32* min_xs,
+    f32* min_ys,
+    f32* max_xs,
+    f32* max_ys,
+    usize count,
+    vec2 margin
+) {
+    for (usize i = 0; i < count; i++) {
+        min_xs[i] -= margin.x;
+        min_ys[i] -= margin.y;
+        max_xs[i] += margin.x;
+        max_ys[i] += margin.y;
+    }
+}
+
+/**
+ * @brief Renumbers the hits a scalar kernel found on the tail of a vector
+ * loop, which count from the tail's first rect, and returns the total.
+ */
+static usize rebase_tail_hits(
+    usize hits,
+    usize start,
+    usize tail_hits,
+    u32* out_indices
+) {
+    for (usize k = hits; k < hits + tail_hits; k++) {
+        out_indices[k] += (u32)start;
+    }
+    return hits + tail_hits;
+}
+
+#if defined(BATCH2D_AVX2)
+// 8 points per iteration. FMA is deliberately not used so results match
+// the scalar kernels bit for bit.
+
+BATCH2D_AVX2_FN static void transform_points_avx2(
+    const affine2& xf,
+    const f32* xs,
+    const f32* ys,
+    f32* out_xs,
+    f32* out_ys,
+    usize count
+) {
+    __m256 m00 = _mm256_set1_ps(xf.m00), m01 = _mm256_set1_ps(xf.m01);
+    __m256 m10 = _mm256_set1_ps(xf.m10), m11 = _mm256_set1_ps(xf.m11);
+    __m256 tx = _mm256_set1_ps(xf.tx), ty = _mm256_set1_ps(xf.ty);
+
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = _mm256_loadu_ps(ys + i);
+        __m256 rx = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)),
+            tx
+        );
+        __m256 ry = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)),
+            ty
+        );
+        _mm256_storeu_ps(out_xs + i, rx);
+        _mm256_storeu_ps(out_ys + i, ry);
+    }
+    transform_points_scalar(xf, xs + i, ys + i, out_xs + i, out_ys + i, count - i);
+}
+
+BATCH2D_AVX2_FN static void offset_scale_rects_avx2(
+    f32* xs,
+    f32* ys,
+    f32* ws,
+    f32* hs,
+    usize count,
+    vec2 offset,
+    vec2 scale
+) {
+    __m256 sx = _mm256_set1_ps(scale.x), sy = _mm256_set1_ps(scale.y);
+    __m256 ox = _mm256_set1_ps(offset.x), oy = _mm256_set1_ps(offset.y);
+
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_mul_ps(_mm256_loadu_ps(xs + i), sx);
+        __m256 y = _mm256_mul_ps(_mm256_loadu_ps(ys + i), sy);
+        _mm256_storeu_ps(xs + i, _mm256_add_ps(x, ox));
+        _mm256_storeu_ps(ys + i, _mm256_add_ps(y, oy));
+        _mm256_storeu_ps(ws + i, _mm256_mul_ps(_mm256_loadu_ps(ws + i), sx));
+        _mm256_storeu_ps(hs + i, _mm256_mul_ps(_mm256_loadu_ps(hs + i), sy));
+    }
+    offset_scale_rects_scalar(xs + i, ys + i, ws + i, hs + i, count - i, offset, scale);
+}
+
+BATCH2D_AVX2_FN static void lerp_avx2(
+    const f32* a,
+    const f32* b,
+    f32 t,
+    f32* out,
+    usize count
+) {
+    __m256 vt = _mm256_set1_ps(t);
+
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 va = _mm256_loadu_ps(a + i);
+        __m256 vb = _mm256_loadu_ps(b + i);
+        __m256 r = _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), vt));
+        _mm256_storeu_ps(out + i, r);
+    }
+    lerp_scalar(a + i, b + i, t, out + i, count - i);
+}
+
+BATCH2D_AVX2_FN static void bounds_avx2(
+    const f32* xs,
+    const f32* ys,
+    usize count,
+    vec2* min,
+    vec2* max
+) {
+    usize i = 0;
+    if (count >= 8) {
+        __m256 min_x = _mm256_loadu_ps(xs), max_x = min_x;
+        __m256 min_y = _mm256_loadu_ps(ys), max_y = min_y;
+        for (i = 8; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+            min_x = _mm256_min_ps(min_x, x);
+            max_x = _mm256_max_ps(max_x, x);
+            min_y = _mm256_min_ps(min_y, y);
+            max_y = _mm256_max_ps(max_y, y);
+        }
+
+        alignas(32) f32 lanes[4][8];
+        _mm256_store_ps(lanes[0], min_x);
+        _mm256_store_ps(lanes[1], min_y);
+        _mm256_store_ps(lanes[2], max_x);
+        _mm256_store_ps(lanes[3], max_y);
+        for (i32 lane = 0; lane < 8; lane++) {
+            min->x = SDL_min(min->x, lanes[0][lane]);
+            min->y = SDL_min(min->y, lanes[1][lane]);
+            max->x = SDL_max(max->x, lanes[2][lane]);
+            max->y = SDL_max(max->y, lanes[3][lane]);
+        }
+    }
+    bounds_scalar(xs + i, ys + i, count - i, min, max);
+}
+
+BATCH2D_AVX2_FN static usize rects_overlap_avx2(
+    const rect2& r,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    __m256 r_min_x = _mm256_set1_ps(r.min.x), r_min_y = _mm256_set1_ps(r.min.y);
+    __m256 r_max_x = _mm256_set1_ps(r.max.x), r_max_y = _mm256_set1_ps(r.max.y);
+
+    usize hits = 0;
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(min_xs + i), r_max_x, _CMP_LT_OQ),
+            _mm256_cmp_ps(r_min_x, _mm256_loadu_ps(max_xs + i), _CMP_LT_OQ)
+        );
+        __m256 y = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(min_ys + i), r_max_y, _CMP_LT_OQ),
+            _mm256_cmp_ps(r_min_y, _mm256_loadu_ps(max_ys + i), _CMP_LT_OQ)
+        );
+        u32 mask = (u32)_mm256_movemask_ps(_mm256_and_ps(x, y));
+        while (mask) {
+            out_indices[hits++] = (u32)i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    usize tail_hits = rects_overlap_scalar(
+        r,
+        min_xs + i,
+        min_ys + i,
+        max_xs + i,
+        max_ys + i,
+        count - i,
+        out_indices + hits
+    );
+    return rebase_tail_hits(hits, i, tail_hits, out_indices);
+}
+
+BATCH2D_AVX2_FN static usize rects_contain_point_avx2(
+    vec2 p,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    __m256 px = _mm256_set1_ps(p.x), py = _mm256_set1_ps(p.y);
+
+    usize hits = 0;
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(min_xs + i), px, _CMP_LE_OQ),
+            _mm256_cmp_ps(px, _mm256_loadu_ps(max_xs + i), _CMP_LT_OQ)
+        );
+        __m256 y = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(min_ys + i), py, _CMP_LE_OQ),
+            _mm256_cmp_ps(py, _mm256_loadu_ps(max_ys + i), _CMP_LT_OQ)
+        );
+        u32 mask = (u32)_mm256_movemask_ps(_mm256_and_ps(x, y));
+        while (mask) {
+            out_indices[hits++] = (u32)i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    usize tail_hits = rects_contain_point_scalar(
+        p,
+        min_xs + i,
+        min_ys + i,
+        max_xs + i,
+        max_ys + i,
+        count - i,
+        out_indices + hits
+    );
+    return rebase_tail_hits(hits, i, tail_hits, out_indices);
+}
+
+BATCH2D_AVX2_FN static void rects_expand_avx2(
+    f32* min_xs,
+    f32* min_ys,
+    f32* max_xs,
+    f32* max_ys,
+    usize count,
+    vec2 margin
+) {
+    __m256 mx = _mm256_set1_ps(margin.x), my = _mm256_set1_ps(margin.y);
+
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(min_xs + i, _mm256_sub_ps(_mm256_loadu_ps(min_xs + i), mx));
+        _mm256_storeu_ps(min_ys + i, _mm256_sub_ps(_mm256_loadu_ps(min_ys + i), my));
+        _mm256_storeu_ps(max_xs + i, _mm256_add_ps(_mm256_loadu_ps(max_xs + i), mx));
+        _mm256_storeu_ps(max_ys + i, _mm256_add_ps(_mm256_loadu_ps(max_ys + i), my));
+    }
+    rects_expand_scalar(min_xs + i, min_ys + i, max_xs + i, max_ys + i, count - i, margin);
+}
+#endif
+
+#if defined(BATCH2D_NEON)
+// 4 points per iteration, without fused multiply-add like the AVX2 path
+
+static void transform_points_neon(
+    const affine2& xf,
+    const f32* xs,
+    const f32* ys,
+    f32* out_xs,
+    f32* out_ys,
+    usize count
+) {
+    float32x4_t m00 = vdupq_n_f32(xf.m00), m01 = vdupq_n_f32(xf.m01);
+    float32x4_t m10 = vdupq_n_f32(xf.m10), m11 = vdupq_n_f32(xf.m11);
+    float32x4_t tx = vdupq_n_f32(xf.tx), ty = vdupq_n_f32(xf.ty);
+
+    usize i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(xs + i);
+        float32x4_t y = vld1q_f32(ys + i);
+        float32x4_t rx =
+            vaddq_f32(vaddq_f32(vmulq_f32(m00, x), vmulq_f32(m01, y)), tx);
+        float32x4_t ry =
+            vaddq_f32(vaddq_f32(vmulq_f32(m10, x), vmulq_f32(m11, y)), ty);
+        vst1q_f32(out_xs + i, rx);
+        vst1q_f32(out_ys + i, ry);
+    }
+    transform_points_scalar(xf, xs + i, ys + i, out_xs + i, out_ys + i, count - i);
+}
+
+static void offset_scale_rects_neon(
+    f32* xs,
+    f32* ys,
+    f32* ws,
+    f32* hs,
+    usize count,
+    vec2 offset,
+    vec2 scale
+) {
+    float32x4_t sx = vdupq_n_f32(scale.x), sy = vdupq_n_f32(scale.y);
+    float32x4_t ox = vdupq_n_f32(offset.x), oy = vdupq_n_f32(offset.y);
+
+    usize i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(xs + i, vaddq_f32(vmulq_f32(vld1q_f32(xs + i), sx), ox));
+        vst1q_f32(ys + i, vaddq_f32(vmulq_f32(vld1q_f32(ys + i), sy), oy));
+        vst1q_f32(ws + i, vmulq_f32(vld1q_f32(ws + i), sx));
+        vst1q_f32(hs + i, vmulq_f32(vld1q_f32(hs + i), sy));
+    }
+    offset_scale_rects_scalar(xs + i, ys + i, ws + i, hs + i, count - i, offset, scale);
+}
+
+static void lerp_neon(const f32* a, const f32* b, f32 t, f32* out, usize count) {
+    float32x4_t vt = vdupq_n_f32(t);
+
+    usize i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t va = vld1q_f32(a + i);
+        float32x4_t vb = vld1q_f32(b + i);
+        vst1q_f32(out + i, vaddq_f32(va, vmulq_f32(vsubq_f32(vb, va), vt)));
+    }
+    lerp_scalar(a + i, b + i, t, out + i, count - i);
+}
+
+static void bounds_neon(
+    const f32* xs,
+    const f32* ys,
+    usize count,
+    vec2* min,
+    vec2* max
+) {
+    usize i = 0;
+    if (count >= 4) {
+        float32x4_t min_x = vld1q_f32(xs), max_x = min_x;
+        float32x4_t min_y = vld1q_f32(ys), max_y = min_y;
+        for (i = 4; i + 4 <= count; i += 4) {
+            float32x4_t x = vld1q_f32(xs + i);
+            float32x4_t y = vld1q_f32(ys + i);
+            min_x = vminq_f32(min_x, x);
+            max_x = vmaxq_f32(max_x, x);
+            min_y = vminq_f32(min_y, y);
+            max_y = vmaxq_f32(max_y, y);
+        }
+
+        f32 lanes[4][4];
+        vst1q_f32(lanes[0], min_x);
+        vst1q_f32(lanes[1], min_y);
+        vst1q_f32(lanes[2], max_x);
+        vst1q_f32(lanes[3], max_y);
+        for (i32 lane = 0; lane < 4; lane++) {
+            min->x = SDL_min(min->x, lanes[0][lane]);
+            min->y = SDL_min(min->y, lanes[1][lane]);
+            max->x = SDL_max(max->x, lanes[2][lane]);
+            max->y = SDL_max(max->y, lanes[3][lane]);
+        }
+    }
+    bounds_scalar(xs + i, ys + i, count - i, min, max);
+}
+
+/**
+ * @brief Appends the indices of the set lanes of a 4-lane compare mask.
+ */
+static usize append_hits_neon(
+    uint32x4_t hit,
+    usize base,
+    usize hits,
+    u32* out_indices
+) {
+    u32 lanes[4];
+    vst1q_u32(lanes, hit);
+    for (u32 lane = 0; lane < 4; lane++) {
+        out_indices[hits] = (u32)base + lane;
+        hits += lanes[lane] & 1;
+    }
+    return hits;
+}
+
+static usize rects_overlap_neon(
+    const rect2& r,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    float32x4_t r_min_x = vdupq_n_f32(r.min.x), r_min_y = vdupq_n_f32(r.min.y);
+    float32x4_t r_max_x = vdupq_n_f32(r.max.x), r_max_y = vdupq_n_f32(r.max.y);
+
+    usize hits = 0;
+    usize i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t x = vandq_u32(
+            vcltq_f32(vld1q_f32(min_xs + i), r_max_x),
+            vcltq_f32(r_min_x, vld1q_f32(max_xs + i))
+        );
+        uint32x4_t y = vandq_u32(
+            vcltq_f32(vld1q_f32(min_ys + i), r_max_y),
+            vcltq_f32(r_min_y, vld1q_f32(max_ys + i))
+        );
+        hits = append_hits_neon(vandq_u32(x, y), i, hits, out_indices);
+    }
+    usize tail_hits = rects_overlap_scalar(
+        r,
+        min_xs + i,
+        min_ys + i,
+        max_xs + i,
+        max_ys + i,
+        count - i,
+        out_indices + hits
+    );
+    return rebase_tail_hits(hits, i, tail_hits, out_indices);
+}
+
+static usize rects_contain_point_neon(
+    vec2 p,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    float32x4_t px = vdupq_n_f32(p.x), py = vdupq_n_f32(p.y);
+
+    usize hits = 0;
+    usize i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t x = vandq_u32(
+            vcleq_f32(vld1q_f32(min_xs + i), px),
+            vcltq_f32(px, vld1q_f32(max_xs + i))
+        );
+        uint32x4_t y = vandq_u32(
+            vcleq_f32(vld1q_f32(min_ys + i), py),
+            vcltq_f32(py, vld1q_f32(max_ys + i))
+        );
+        hits = append_hits_neon(vandq_u32(x, y), i, hits, out_indices);
+    }
+    usize tail_hits = rects_contain_point_scalar(
+        p,
+        min_xs + i,
+        min_ys + i,
+        max_xs + i,
+        max_ys + i,
+        count - i,
+        out_indices + hits
+    );
+    return rebase_tail_hits(hits, i, tail_hits, out_indices);
+}
+
+static void rects_expand_neon(
+    f32* min_xs,
+    f32* min_ys,
+    f32* max_xs,
+    f32* max_ys,
+    usize count,
+    vec2 margin
+) {
+    float32x4_t mx = vdupq_n_f32(margin.x), my = vdupq_n_f32(margin.y);
+
+    usize i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(min_xs + i, vsubq_f32(vld1q_f32(min_xs + i), mx));
+        vst1q_f32(min_ys + i, vsubq_f32(vld1q_f32(min_ys + i), my));
+        vst1q_f32(max_xs + i, vaddq_f32(vld1q_f32(max_xs + i), mx));
+        vst1q_f32(max_ys + i, vaddq_f32(vld1q_f32(max_ys + i), my));
+    }
+    rects_expand_scalar(min_xs + i, min_ys + i, max_xs + i, max_ys + i, count - i, margin);
+}
+#endif
+
+static const Batch2dKernels batch2d_scalar_kernels{
+    "scalar",
+    transform_points_scalar,
+    offset_scale_rects_scalar,
+    lerp_scalar,
+    bounds_scalar,
+    rects_overlap_scalar,
+    rects_contain_point_scalar,
+    rects_expand_scalar,
+};
+
+/**
+ * @brief Picks the widest kernel set supported by the running CPU.
+ *
+ * Resolved once on first use; the function-local static makes the choice
+ * thread-safe.
+ */
+static const Batch2dKernels* get_batch2d_kernels() {
+    static const Batch2dKernels* kernels = []() {
+#if defined(BATCH2D_AVX2)
+        static const Batch2dKernels avx2{
+            "avx2",
+            transform_points_avx2,
+            offset_scale_rects_avx2,
+            lerp_avx2,
+            bounds_avx2,
+            rects_overlap_avx2,
+            rects_contain_point_avx2,
+            rects_expand_avx2,
+        };
+        if (SDL_HasAVX2()) return &avx2;
+#elif defined(BATCH2D_NEON)
+        static const Batch2dKernels neon{
+            "neon",
+            transform_points_neon,
+            offset_scale_rects_neon,
+            lerp_neon,
+            bounds_neon,
+            rects_overlap_neon,
+            rects_contain_point_neon,
+            rects_expand_neon,
+        };
+        if (SDL_HasNEON()) return &neon;
+#endif
+        return &batch2d_scalar_kernels;
+    }();
+    return kernels;
+}
+
+void batch_transform_points(
+    const affine2& xf,
+    const f32* xs,
+    const f32* ys,
+    f32* out_xs,
+    f32* out_ys,
+    usize count
+) {
+    get_batch2d_kernels()->transform_points(xf, xs, ys, out_xs, out_ys, count);
+}
+
+void batch_offset_scale_rects(
+    f32* xs,
+    f32* ys,
+    f32* ws,
+    f32* hs,
+    usize count,
+    vec2 offset,
+    vec2 scale
+) {
+    get_batch2d_kernels()->offset_scale_rects(xs, ys, ws, hs, count, offset, scale);
+}
+
+void batch_lerp(const f32* a, const f32* b, f32 t, f32* out, usize count) {
+    get_batch2d_kernels()->lerp(a, b, t, out, count);
+}
+
+bool batch_bounds(
+    const f32* xs,
+    const f32* ys,
+    usize count,
+    vec2* min,
+    vec2* max
+) {
+    if (count == 0) return false;
+
+    *min = vec2(xs[0], ys[0]);
+    *max = *min;
+    get_batch2d_kernels()->bounds(xs, ys, count, min, max);
+    return true;
+}
+
+usize batch_rects_overlap(
+    const rect2& r,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    return get_batch2d_kernels()
+        ->rects_overlap(r, min_xs, min_ys, max_xs, max_ys, count, out_indices);
+}
+
+usize batch_rects_contain_point(
+    vec2 p,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+) {
+    return get_batch2d_kernels()
+        ->rects_contain_point(p, min_xs, min_ys, max_xs, max_ys, count, out_indices);
+}
+
+/**
+ * @brief Sweep-and-prune over rects sorted by min_x.
+ *
+ * For each rect, a binary search finds the end of the run of later rects
+ * that start before it ends on x; only that run goes through the overlap
+ * kernel, in chunks that fit a stack buffer of indices.
+ */
+usize batch_rects_overlap_pairs(
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    RectPair* out_pairs,
+    usize max_pairs
+) {
+    const Batch2dKernels* kernels = get_batch2d_kernels();
+    constexpr usize chunk_size = 256;
+    u32 hits[chunk_size];
+    usize pair_count = 0;
+
+    for (usize a = 0; a < count; a++) {
+        rect2 r(vec2(min_xs[a], min_ys[a]), vec2(max_xs[a], max_ys[a]));
+
+        usize lo = a + 1;
+        usize hi = count;
+        while (lo < hi) {
+            usize mid = lo + (hi - lo) / 2;
+            if (min_xs[mid] < r.max.x) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        for (usize start = a + 1; start < lo; start += chunk_size) {
+            usize n = SDL_min(lo - start, chunk_size);
+            usize hit_count = kernels->rects_overlap(
+                r,
+                min_xs + start,
+                min_ys + start,
+                max_xs + start,
+                max_ys + start,
+                n,
+                hits
+            );
+            for (usize k = 0; k < hit_count; k++) {
+                if (pair_count < max_pairs) {
+                    out_pairs[pair_count] = {(u32)a, (u32)(start + hits[k])};
+                }
+                pair_count++;
+            }
+        }
+    }
+    return pair_count;
+}
+
+/**
+ * @brief Merges rects through the bounds kernel, once over the min streams
+ * and once over the max streams.
+ */
+bool batch_rects_merge(
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    rect2* out
+) {
+    vec2 unused;
+    if (!batch_bounds(min_xs, min_ys, count, &out->min, &unused)) return false;
+    batch_bounds(max_xs, max_ys, count, &unused, &out->max);
+    return true;
+}
+
+void batch_rects_expand(
+    f32* min_xs,
+    f32* min_ys,
+    f32* max_xs,
+    f32* max_ys,
+    usize count,
+    vec2 margin
+) {
+    get_batch2d_kernels()->rects_expand(min_xs, min_ys, max_xs, max_ys, count, margin);
+}
+
+const char* batch2d_backend_name() {
+    return get_batch2d_kernels()->name;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "core/math3d.h"
+#include "core/types.h"
+
+// 2D affine transform: x' = m00 * x + m01 * y + tx, y' = m10 * x + m11 * y + ty
+struct affine2 {
+    f32 m00{1}, m01{0}, tx{0};
+    f32 m10{0}, m11{1}, ty{0};
+
+    // FromMat4x4: Takes the 2D part of `m` (as applied by mat4x4 * vec4)
+    static affine2 from_mat4x4(const mat4x4& m);
+};
+
+// Bulk kernels over structure-of-arrays float streams: positions are passed
+// as separate x and y arrays. Each kernel has scalar, AVX2 and NEON
+// versions; the widest one the CPU supports is picked on first use. Output
+// streams may alias the matching input streams.
+
+// TransformPoints: out[i] = xf * (xs[i], ys[i])
+void batch_transform_points(
+    const affine2& xf,
+    const f32* xs,
+    const f32* ys,
+    f32* out_xs,
+    f32* out_ys,
+    usize count
+);
+
+// OffsetScaleRects: pos = pos * scale + offset and size = size * scale, in
+// place, for `count` rects stored as x, y, w, h streams
+void batch_offset_scale_rects(
+    f32* xs,
+    f32* ys,
+    f32* ws,
+    f32* hs,
+    usize count,
+    vec2 offset,
+    vec2 scale
+);
+
+// Lerp: out[i] = a[i] + (b[i] - a[i]) * t
+void batch_lerp(const f32* a, const f32* b, f32 t, f32* out, usize count);
+
+// Bounds: Min and max corner of `count` points. Returns false if count is 0.
+bool batch_bounds(
+    const f32* xs,
+    const f32* ys,
+    usize count,
+    vec2* min,
+    vec2* max
+);
+
+// Rect kernels work on `count` rects stored as min_x, min_y, max_x and
+// max_y streams, with the half-open edges of rect2.
+
+struct RectPair {
+    u32 a;
+    u32 b;
+};
+
+// RectsOverlap: Writes the indices of the rects overlapping `r` to
+// out_indices in ascending order and returns how many there are.
+// out_indices needs room for `count` entries.
+usize batch_rects_overlap(
+    const rect2& r,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+);
+
+// RectsContainPoint: Like RectsOverlap, for the rects containing `p`
+usize batch_rects_contain_point(
+    vec2 p,
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    u32* out_indices
+);
+
+// RectsOverlapPairs: Finds every overlapping pair (a < b) among rects sorted
+// by ascending min_x, sweeping along x so only rects whose x ranges meet are
+// tested. Writes up to max_pairs pairs and returns the total number found;
+// a result above max_pairs means out_pairs was too small.
+usize batch_rects_overlap_pairs(
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    RectPair* out_pairs,
+    usize max_pairs
+);
+
+// RectsMerge: Smallest rect covering all rects. Returns false if count is 0.
+bool batch_rects_merge(
+    const f32* min_xs,
+    const f32* min_ys,
+    const f32* max_xs,
+    const f32* max_ys,
+    usize count,
+    rect2* out
+);
+
+// RectsExpand: Grows every rect by `margin` on each side, in place
+void batch_rects_expand(
+    f32* min_xs,
+    f32* min_ys,
+    f32* max_xs,
+    f32* max_ys,
+    usize count,
+    vec2 margin
+);
+
+// Name of the kernel set in use ("avx2", "neon" or "scalar")
+const char* batch2d_backend_name();
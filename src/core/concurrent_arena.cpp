@@ -0,0 +1,245 @@
+#include "core/concurrent_arena.h"
+#include "core/assert.h"
+#include "core/virtual_memory.h"
+
+#include <SDL3/SDL.h>
+#include <new>
+
+// Chunk a thread bumps small allocations out of, tagged with its arena
+struct ConcurrentArenaCache {
+    ConcurrentArena* arena;
+    u64 generation;
+    u8* cursor;
+    u8* end;
+};
+
+static thread_local ConcurrentArenaCache
+    concurrent_arena_caches[CONCURRENT_ARENA_THREAD_CACHES];
+static thread_local u32 concurrent_arena_next_cache;
+
+// Generations are unique across all arenas, so a cache left behind by a
+// destroyed arena never matches a new one created at the same address
+static std::atomic<u64> concurrent_arena_generations{1};
+
+static inline usize concurrent_align(usize value, usize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+ConcurrentArena::ConcurrentArena(usize block_reserve, usize thread_chunk_size)
+    : current_block(nullptr),
+      generation(concurrent_arena_generations.fetch_add(1)),
+      block_reserve(block_reserve),
+      thread_chunk_size(thread_chunk_size) {
+    DEBUG_ASSERT(block_reserve != 0, "Block reserve cannot be zero.");
+    current_block.store(create_block(block_reserve), std::memory_order_release);
+}
+
+void ConcurrentArena::destroy() {
+    ConcurrentArenaBlock* block = current_block.load(std::memory_order_acquire);
+    while (block) {
+        ConcurrentArenaBlock* older = block->next;
+        release_block(block);
+        block = older;
+    }
+    current_block.store(nullptr, std::memory_order_release);
+    generation.store(
+        concurrent_arena_generations.fetch_add(1),
+        std::memory_order_release
+    );
+}
+
+void* ConcurrentArena::push(usize size, usize alignment) {
+    DEBUG_ASSERT(size != 0, "Can't push 0 bytes of memory");
+    DEBUG_ASSERT(
+        (alignment & (alignment - 1)) == 0,
+        "Alignment must be a power of two."
+    );
+
+    // Large pushes would drain a chunk at once, send them to the block
+    if (size + alignment > thread_chunk_size / 4) {
+        return push_shared(size, alignment);
+    }
+
+    u64 current_generation = generation.load(std::memory_order_acquire);
+    ConcurrentArenaCache* cache = nullptr;
+    for (u32 i = 0; i < CONCURRENT_ARENA_THREAD_CACHES; i++) {
+        if (concurrent_arena_caches[i].arena == this) {
+            cache = &concurrent_arena_caches[i];
+            break;
+        }
+    }
+    if (!cache) {
+        cache = &concurrent_arena_caches[concurrent_arena_next_cache];
+        concurrent_arena_next_cache =
+            (concurrent_arena_next_cache + 1) % CONCURRENT_ARENA_THREAD_CACHES;
+        *cache = {this, current_generation, nullptr, nullptr};
+    }
+
+    u8* aligned = (u8*)concurrent_align((usize)cache->cursor, alignment);
+    if (cache->generation != current_generation || !cache->cursor ||
+        aligned + size > cache->end) {
+        u8* chunk = (u8*)push_shared(thread_chunk_size, 64);
+        if (!chunk) {
+            return nullptr;
+        }
+        cache->generation = current_generation;
+        cache->cursor = chunk;
+        cache->end = chunk + thread_chunk_size;
+        aligned = (u8*)concurrent_align((usize)cache->cursor, alignment);
+    }
+
+    cache->cursor = aligned + size;
+    return aligned;
+}
+
+void* ConcurrentArena::push_zero(usize size, usize alignment) {
+    void* ptr = push(size, alignment);
+    if (ptr) {
+        SDL_memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+void ConcurrentArena::clear() {
+    ConcurrentArenaBlock* block = current_block.load(std::memory_order_acquire);
+    if (!block) return;
+
+    // Keep only the oldest block, like Arena::clear
+    while (block->next) {
+        ConcurrentArenaBlock* older = block->next;
+        release_block(block);
+        block = older;
+    }
+    block->used.store(0, std::memory_order_relaxed);
+    current_block.store(block, std::memory_order_release);
+    generation.store(
+        concurrent_arena_generations.fetch_add(1),
+        std::memory_order_release
+    );
+}
+
+usize ConcurrentArena::get_total_used_size() {
+    usize total = 0;
+    ConcurrentArenaBlock* block = current_block.load(std::memory_order_acquire);
+    for (; block; block = block->next) {
+        total += SDL_min(
+            block->used.load(std::memory_order_relaxed),
+            block->capacity
+        );
+    }
+    return total;
+}
+
+template <typename T>
+T* ConcurrentArena::push_array(usize count, usize alignment) {
+    return (T*)push(sizeof(T) * count, alignment);
+}
+
+void* ConcurrentArena::push_shared(usize size, usize alignment) {
+    usize padded_size = size + alignment - 1;
+
+    for (;;) {
+        ConcurrentArenaBlock* block =
+            current_block.load(std::memory_order_acquire);
+        usize offset =
+            block->used.fetch_add(padded_size, std::memory_order_relaxed);
+
+        if (offset + padded_size <= block->capacity) {
+            usize start =
+                concurrent_align((usize)block->memory + offset, alignment) -
+                (usize)block->memory;
+            if (!commit(block, start + size)) {
+                DEBUG_ASSERT(false, "Failed to commit arena memory.");
+                return nullptr;
+            }
+            return block->memory + start;
+        }
+
+        // The block is exhausted; whoever wins the CAS installs a new one
+        // and everyone retries on it
+        if (!grow(block, padded_size)) {
+            return nullptr;
+        }
+    }
+}
+
+bool ConcurrentArena::grow(ConcurrentArenaBlock* full_block, usize min_size) {
+    if (current_block.load(std::memory_order_acquire) != full_block) {
+        return true; // Another thread already grew the arena
+    }
+
+    ConcurrentArenaBlock* new_block =
+        create_block(SDL_max(block_reserve, min_size));
+    if (!new_block) {
+        return false;
+    }
+    new_block->next = full_block;
+
+    ConcurrentArenaBlock* expected = full_block;
+    if (!current_block.compare_exchange_strong(
+            expected,
+            new_block,
+            std::memory_order_acq_rel
+        )) {
+        release_block(new_block);
+    }
+    return true;
+}
+
+bool ConcurrentArena::commit(ConcurrentArenaBlock* block, usize end) {
+    usize committed = block->committed.load(std::memory_order_acquire);
+    if (end <= committed) {
+        return true;
+    }
+
+    // Commit everything from the watermark up, not just our own range: a
+    // raised watermark promises every page below it is accessible.
+    // Committing a page twice is harmless, so racing threads may overlap.
+    usize page_size = vm_page_size();
+    usize start = committed & ~(page_size - 1);
+    usize target = SDL_min(
+        concurrent_align(end, CONCURRENT_ARENA_THREAD_CHUNK),
+        block->capacity
+    );
+    if (!vm_commit(block->memory + start, target - start)) {
+        return false;
+    }
+
+    while (committed < target &&
+           !block->committed.compare_exchange_weak(
+               committed,
+               target,
+               std::memory_order_acq_rel
+           )) {
+    }
+    return true;
+}
+
+ConcurrentArenaBlock* ConcurrentArena::create_block(usize capacity) {
+    capacity = concurrent_align(capacity, CONCURRENT_ARENA_THREAD_CHUNK);
+
+    void* header = SDL_malloc(sizeof(ConcurrentArenaBlock));
+    if (!header) {
+        return nullptr;
+    }
+    u8* memory = (u8*)vm_reserve(capacity);
+    if (!memory) {
+        SDL_Log("Failed to reserve concurrent arena block of %zu bytes", capacity);
+        SDL_free(header);
+        return nullptr;
+    }
+
+    ConcurrentArenaBlock* block = new (header) ConcurrentArenaBlock();
+    block->memory = memory;
+    block->capacity = capacity;
+    block->used.store(0, std::memory_order_relaxed);
+    block->committed.store(0, std::memory_order_relaxed);
+    block->next = nullptr;
+    return block;
+}
+
+void ConcurrentArena::release_block(ConcurrentArenaBlock* block) {
+    vm_release(block->memory, block->capacity);
+    block->~ConcurrentArenaBlock();
+    SDL_free(block);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <atomic>
+
+// Default address space reserved per block and per-thread chunk size
+#define CONCURRENT_ARENA_RESERVE ((usize)256 * 1024 * 1024)
+#define CONCURRENT_ARENA_THREAD_CHUNK ((usize)64 * 1024)
+// Number of arenas a thread keeps a local chunk for at the same time
+#define CONCURRENT_ARENA_THREAD_CACHES 4
+
+struct ConcurrentArenaBlock {
+    u8* memory;
+    usize capacity;
+    std::atomic<usize> used;      // Bump offset shared by all threads
+    std::atomic<usize> committed; // Every page below this is committed
+    ConcurrentArenaBlock* next;   // Older block
+};
+
+// Arena that many threads can push into without a lock. Blocks are virtual
+// reservations; allocation is an atomic fetch_add on the block offset and
+// pages are committed by whichever thread first needs them. Small pushes are
+// served from a chunk cached per thread, so most of them touch no shared
+// cache line at all. When a block runs out, racing threads each try to
+// install a new one with a CAS and the losers release theirs.
+//
+// clear() and destroy() are NOT thread-safe: call them once every producer
+// is done with the arena (e.g. between frames).
+struct ConcurrentArena {
+    ConcurrentArena(
+        usize block_reserve = CONCURRENT_ARENA_RESERVE,
+        usize thread_chunk_size = CONCURRENT_ARENA_THREAD_CHUNK
+    );
+
+    void destroy();
+
+    // Push: Thread-safe allocation of `size` bytes.
+    void* push(usize size, usize alignment = 8);
+    void* push_zero(usize size, usize alignment = 8);
+
+    // Clear: Rewinds the arena and invalidates every thread's cached chunk.
+    void clear();
+
+    // Sum of the offsets of all blocks, including per-thread chunk slack.
+    usize get_total_used_size();
+
+    template <typename T>
+    T* push_array(usize count, usize alignment = alignof(T));
+
+  private:
+    std::atomic<ConcurrentArenaBlock*> current_block;
+    // Renewed by clear() so thread caches know their chunk is stale
+    std::atomic<u64> generation;
+    usize block_reserve;
+    usize thread_chunk_size;
+
+    void* push_shared(usize size, usize alignment);
+    bool grow(ConcurrentArenaBlock* full_block, usize min_capacity);
+    bool commit(ConcurrentArenaBlock* block, usize end);
+    ConcurrentArenaBlock* create_block(usize capacity);
+    void release_block(ConcurrentArenaBlock* block);
+};
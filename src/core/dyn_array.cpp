@@ -0,0 +1,85 @@
+#include "core/dyn_array.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+#include <type_traits>
+
+#define DYN_ARRAY_MIN_CAPACITY 16
+
+template <typename T>
+DynArray<T>::DynArray(Arena* arena, usize initial_capacity) : arena(arena) {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "DynArray elements are relocated with memcpy"
+    );
+    if (initial_capacity > 0) {
+        reserve(initial_capacity);
+    }
+}
+
+template <typename T> T& DynArray<T>::operator[](usize idx) {
+    DEBUG_ASSERT(idx < size, "DynArray access out of bounds");
+    return items[idx];
+}
+
+template <typename T> usize DynArray<T>::push(T item) {
+    if (size == capacity) {
+        reserve(size + 1);
+    }
+    items[size] = item;
+    return size++;
+}
+
+template <typename T> T& DynArray<T>::pop() {
+    DEBUG_ASSERT(size > 0, "DynArray is empty");
+    return items[--size];
+}
+
+template <typename T> void DynArray<T>::push_n(const T* src, usize count) {
+    if (count == 0) return;
+    T* dst = push_uninit(count);
+    SDL_memcpy(dst, src, sizeof(T) * count);
+}
+
+template <typename T> void DynArray<T>::append(std::span<const T> src) {
+    push_n(src.data(), src.size());
+}
+
+template <typename T> T* DynArray<T>::push_uninit(usize count) {
+    if (size + count > capacity) {
+        reserve(size + count);
+    }
+    T* first = items + size;
+    size += count;
+    return first;
+}
+
+template <typename T> void DynArray<T>::reserve(usize min_capacity) {
+    DEBUG_ASSERT(arena != nullptr, "DynArray has no arena");
+    if (min_capacity <= capacity) return;
+
+    usize new_capacity = SDL_max(capacity * 2, DYN_ARRAY_MIN_CAPACITY);
+    new_capacity = SDL_max(new_capacity, min_capacity);
+
+    if (items &&
+        arena->extend(items, sizeof(T) * capacity, sizeof(T) * new_capacity)) {
+        capacity = new_capacity;
+        return;
+    }
+
+    T* new_items = arena->push_array<T>(new_capacity);
+    DEBUG_ASSERT(new_items != nullptr, "DynArray failed to grow");
+    if (items) {
+        SDL_memcpy(new_items, items, sizeof(T) * size);
+    }
+    items = new_items;
+    capacity = new_capacity;
+}
+
+template <typename T> void DynArray<T>::clear() {
+    size = 0;
+}
+
+template <typename T> bool DynArray<T>::is_empty() {
+    return size == 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+
+#include <span>
+
+// Growable array whose storage comes from an arena. Capacity doubles on
+// growth; when the array is the most recent allocation in its arena it is
+// extended in place, otherwise it moves and the old storage is left to the
+// arena. Elements must be trivially copyable since they are moved by memcpy.
+template <typename T> struct DynArray {
+    Arena* arena{};
+    T* items{};
+    usize size{};
+    usize capacity{};
+
+    DynArray() = default;
+    DynArray(Arena* arena, usize initial_capacity = 0);
+
+    T& operator[](usize idx);
+    usize push(T item);
+    T& pop();
+    // PushN: Appends `count` items copied from `src` with a single memcpy.
+    void push_n(const T* src, usize count);
+    void append(std::span<const T> src);
+    // PushUninit: Appends `count` items without initializing them and
+    // returns a pointer to the first one.
+    T* push_uninit(usize count);
+    void reserve(usize min_capacity);
+    void clear();
+    bool is_empty();
+};
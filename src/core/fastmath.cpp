@@ -0,0 +1,322 @@
+#include "core/fastmath.h"
+
+#include <bit>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FASTMATH_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FASTMATH_NEON
+#endif
+
+#define FM_PI 3.14159265358979f
+#define FM_HALF_PI 1.57079632679490f
+#define FM_INV_TWO_PI 0.159154943091895f
+// 2*pi and ln(2) split in two so k * HI is exact (Cody-Waite reduction)
+#define FM_TWO_PI_HI 6.28125f
+#define FM_TWO_PI_LO 1.93530717958647692e-3f
+#define FM_LN2_HI 0.693359375f
+#define FM_LN2_LO -2.12194440e-4f
+#define FM_LOG2E 1.44269504088896341f
+// Adding and subtracting 1.5 * 2^23 rounds to the nearest integer
+#define FM_ROUND_MAGIC 12582912.0f
+
+// Lane operations. Every kernel below is a template over the lane type, so
+// the scalar (f32) and vector instantiations run the same algorithm and
+// round identically.
+
+static inline f32 fm_splat(f32 v, f32) { return v; }
+static inline f32 fm_add(f32 a, f32 b) { return a + b; }
+static inline f32 fm_sub(f32 a, f32 b) { return a - b; }
+static inline f32 fm_mul(f32 a, f32 b) { return a * b; }
+static inline f32 fm_div(f32 a, f32 b) { return a / b; }
+static inline f32 fm_min(f32 a, f32 b) { return a < b ? a : b; }
+static inline f32 fm_max(f32 a, f32 b) { return a > b ? a : b; }
+static inline f32 fm_abs(f32 a) {
+    return std::bit_cast<f32>(std::bit_cast<u32>(a) & 0x7FFFFFFFu);
+}
+// CopySign: |a| with the sign of b
+static inline f32 fm_copysign(f32 a, f32 b) {
+    return std::bit_cast<f32>(
+        (std::bit_cast<u32>(a) & 0x7FFFFFFFu) |
+        (std::bit_cast<u32>(b) & 0x80000000u)
+    );
+}
+static inline bool fm_gt(f32 a, f32 b) { return a > b; }
+static inline f32 fm_select(bool mask, f32 a, f32 b) { return mask ? a : b; }
+// Exp2i: 2^n for an integral n in [-126, 127]
+static inline f32 fm_exp2i(f32 n) {
+    return std::bit_cast<f32>((u32)((i32)n + 127) << 23);
+}
+
+#if defined(FASTMATH_SSE)
+typedef __m128 fm_v;
+
+static inline fm_v fm_splat(f32 v, fm_v) { return _mm_set1_ps(v); }
+static inline fm_v fm_add(fm_v a, fm_v b) { return _mm_add_ps(a, b); }
+static inline fm_v fm_sub(fm_v a, fm_v b) { return _mm_sub_ps(a, b); }
+static inline fm_v fm_mul(fm_v a, fm_v b) { return _mm_mul_ps(a, b); }
+static inline fm_v fm_div(fm_v a, fm_v b) { return _mm_div_ps(a, b); }
+static inline fm_v fm_min(fm_v a, fm_v b) { return _mm_min_ps(a, b); }
+static inline fm_v fm_max(fm_v a, fm_v b) { return _mm_max_ps(a, b); }
+static inline fm_v fm_abs(fm_v a) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+static inline fm_v fm_copysign(fm_v a, fm_v b) {
+    fm_v sign = _mm_set1_ps(-0.0f);
+    return _mm_or_ps(_mm_andnot_ps(sign, a), _mm_and_ps(sign, b));
+}
+static inline fm_v fm_gt(fm_v a, fm_v b) { return _mm_cmpgt_ps(a, b); }
+static inline fm_v fm_select(fm_v mask, fm_v a, fm_v b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+static inline fm_v fm_exp2i(fm_v n) {
+    __m128i bits = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+    return _mm_castsi128_ps(_mm_slli_epi32(bits, 23));
+}
+static inline fm_v fm_load(const f32* p) { return _mm_loadu_ps(p); }
+static inline void fm_store(f32* p, fm_v v) { _mm_storeu_ps(p, v); }
+#elif defined(FASTMATH_NEON)
+typedef float32x4_t fm_v;
+
+static inline fm_v fm_splat(f32 v, fm_v) { return vdupq_n_f32(v); }
+static inline fm_v fm_add(fm_v a, fm_v b) { return vaddq_f32(a, b); }
+static inline fm_v fm_sub(fm_v a, fm_v b) { return vsubq_f32(a, b); }
+static inline fm_v fm_mul(fm_v a, fm_v b) { return vmulq_f32(a, b); }
+static inline fm_v fm_div(fm_v a, fm_v b) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vdivq_f32(a, b);
+#else
+    f32 la[4], lb[4];
+    vst1q_f32(la, a);
+    vst1q_f32(lb, b);
+    for (i32 i = 0; i < 4; i++) la[i] /= lb[i];
+    return vld1q_f32(la);
+#endif
+}
+static inline fm_v fm_min(fm_v a, fm_v b) { return vminq_f32(a, b); }
+static inline fm_v fm_max(fm_v a, fm_v b) { return vmaxq_f32(a, b); }
+static inline fm_v fm_abs(fm_v a) { return vabsq_f32(a); }
+static inline fm_v fm_copysign(fm_v a, fm_v b) {
+    return vbslq_f32(vdupq_n_u32(0x80000000u), b, a);
+}
+static inline uint32x4_t fm_gt(fm_v a, fm_v b) { return vcgtq_f32(a, b); }
+static inline fm_v fm_select(uint32x4_t mask, fm_v a, fm_v b) {
+    return vbslq_f32(mask, a, b);
+}
+static inline fm_v fm_exp2i(fm_v n) {
+    int32x4_t bits = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+    return vreinterpretq_f32_s32(vshlq_n_s32(bits, 23));
+}
+static inline fm_v fm_load(const f32* p) { return vld1q_f32(p); }
+static inline void fm_store(f32* p, fm_v v) { vst1q_f32(p, v); }
+#endif
+
+template <typename V> static inline V fm_round(V x) {
+    V magic = fm_splat(FM_ROUND_MAGIC, x);
+    return fm_sub(fm_add(x, magic), magic);
+}
+
+// Reduces x to [-pi, pi]
+template <typename V> static inline V reduce_two_pi(V x) {
+    V k = fm_round(fm_mul(x, fm_splat(FM_INV_TWO_PI, x)));
+    x = fm_sub(x, fm_mul(k, fm_splat(FM_TWO_PI_HI, x)));
+    return fm_sub(x, fm_mul(k, fm_splat(FM_TWO_PI_LO, x)));
+}
+
+// Taylor series of sin up to x^11, accurate to ~6e-8 on [-pi/2, pi/2]
+template <typename V> static inline V sin_poly(V x) {
+    V x2 = fm_mul(x, x);
+    V p = fm_splat(-2.5052108e-8f, x);
+    p = fm_add(fm_mul(p, x2), fm_splat(2.7557319e-6f, x));
+    p = fm_add(fm_mul(p, x2), fm_splat(-1.9841270e-4f, x));
+    p = fm_add(fm_mul(p, x2), fm_splat(8.3333333e-3f, x));
+    p = fm_add(fm_mul(p, x2), fm_splat(-1.6666667e-1f, x));
+    return fm_add(x, fm_mul(fm_mul(x, x2), p));
+}
+
+template <typename V> static inline V sin_kernel(V x) {
+    // Fold to [-pi/2, pi/2] with sin(x) = sin(+-pi - x). Rounding in the
+    // reduction can leave |x| slightly above pi; the fold still lands on the
+    // right side of zero then
+    x = reduce_two_pi(x);
+    x = fm_select(
+        fm_gt(fm_abs(x), fm_splat(FM_HALF_PI, x)),
+        fm_sub(fm_copysign(fm_splat(FM_PI, x), x), x),
+        x
+    );
+    return sin_poly(x);
+}
+
+template <typename V> static inline V cos_kernel(V x) {
+    // cos(x) = sin(pi/2 - |x|), already in range after the reduction. Adding
+    // pi/2 before reducing would round away low bits of large inputs
+    x = reduce_two_pi(x);
+    return sin_poly(fm_sub(fm_splat(FM_HALF_PI, x), fm_abs(x)));
+}
+
+template <typename V> static inline V atan2_kernel(V y, V x) {
+    V ax = fm_abs(x);
+    V ay = fm_abs(y);
+    V hi = fm_max(ax, ay);
+    V lo = fm_min(ax, ay);
+    V zero = fm_splat(0.0f, x);
+    // a = lo / hi in [0, 1]; atan2(0, 0) is taken as 0
+    auto nonzero = fm_gt(hi, zero);
+    V a = fm_div(lo, fm_select(nonzero, hi, fm_splat(1.0f, x)));
+    a = fm_select(nonzero, a, zero);
+
+    V s = fm_mul(a, a);
+    V p = fm_splat(-0.01172120f, x);
+    p = fm_add(fm_mul(p, s), fm_splat(0.05265332f, x));
+    p = fm_add(fm_mul(p, s), fm_splat(-0.11643287f, x));
+    p = fm_add(fm_mul(p, s), fm_splat(0.19354346f, x));
+    p = fm_add(fm_mul(p, s), fm_splat(-0.33262347f, x));
+    p = fm_add(fm_mul(p, s), fm_splat(0.99997726f, x));
+    V r = fm_mul(p, a);
+
+    r = fm_select(fm_gt(ay, ax), fm_sub(fm_splat(FM_HALF_PI, x), r), r);
+    r = fm_select(fm_gt(zero, x), fm_sub(fm_splat(FM_PI, x), r), r);
+    return fm_copysign(r, y);
+}
+
+template <typename V> static inline V exp_kernel(V x) {
+    x = fm_min(fm_max(x, fm_splat(-87.0f, x)), fm_splat(88.0f, x));
+
+    // e^x = 2^n * e^f with f = x - n*ln2 in [-ln2/2, ln2/2]
+    V n = fm_round(fm_mul(x, fm_splat(FM_LOG2E, x)));
+    V f = fm_sub(x, fm_mul(n, fm_splat(FM_LN2_HI, x)));
+    f = fm_sub(f, fm_mul(n, fm_splat(FM_LN2_LO, x)));
+
+    // Cephes expf polynomial: e^f = 1 + f + f^2 * P(f)
+    V p = fm_splat(1.9875691500e-4f, x);
+    p = fm_add(fm_mul(p, f), fm_splat(1.3981999507e-3f, x));
+    p = fm_add(fm_mul(p, f), fm_splat(8.3334519073e-3f, x));
+    p = fm_add(fm_mul(p, f), fm_splat(4.1665795894e-2f, x));
+    p = fm_add(fm_mul(p, f), fm_splat(1.6666665459e-1f, x));
+    p = fm_add(fm_mul(p, f), fm_splat(5.0000001201e-1f, x));
+    V e = fm_add(fm_add(fm_mul(fm_mul(f, f), p), f), fm_splat(1.0f, x));
+    return fm_mul(e, fm_exp2i(n));
+}
+
+#if defined(FASTMATH_SSE)
+static inline fm_v rsqrt_kernel(fm_v x) {
+    // 12-bit hardware estimate refined by one Newton-Raphson step
+    fm_v y = _mm_rsqrt_ps(x);
+    fm_v xyy = _mm_mul_ps(_mm_mul_ps(x, y), y);
+    return _mm_mul_ps(
+        _mm_mul_ps(_mm_set1_ps(0.5f), y),
+        _mm_sub_ps(_mm_set1_ps(3.0f), xyy)
+    );
+}
+#elif defined(FASTMATH_NEON)
+static inline fm_v rsqrt_kernel(fm_v x) {
+    // 8-bit hardware estimate refined by two Newton-Raphson steps
+    fm_v y = vrsqrteq_f32(x);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+    return y;
+}
+#endif
+
+f32 fast_rsqrt(f32 x) {
+#if defined(FASTMATH_SSE) || defined(FASTMATH_NEON)
+    f32 lanes[4] = {x, x, x, x};
+    fm_store(lanes, rsqrt_kernel(fm_load(lanes)));
+    return lanes[0];
+#else
+    // Bit-level initial guess refined by two Newton-Raphson steps
+    f32 y = std::bit_cast<f32>(0x5F375A86u - (std::bit_cast<u32>(x) >> 1));
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+#endif
+}
+
+f32 fast_sin(f32 x) {
+    return sin_kernel(x);
+}
+
+f32 fast_cos(f32 x) {
+    return cos_kernel(x);
+}
+
+f32 fast_atan2(f32 y, f32 x) {
+    return atan2_kernel(y, x);
+}
+
+f32 fast_exp(f32 x) {
+    return exp_kernel(x);
+}
+
+void fast_rsqrt_n(const f32* x, f32* out, usize count) {
+    usize i = 0;
+#if defined(FASTMATH_SSE) || defined(FASTMATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        fm_store(out + i, rsqrt_kernel(fm_load(x + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = fast_rsqrt(x[i]);
+    }
+}
+
+void fast_sin_n(const f32* x, f32* out, usize count) {
+    usize i = 0;
+#if defined(FASTMATH_SSE) || defined(FASTMATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        fm_store(out + i, sin_kernel(fm_load(x + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = sin_kernel(x[i]);
+    }
+}
+
+void fast_cos_n(const f32* x, f32* out, usize count) {
+    usize i = 0;
+#if defined(FASTMATH_SSE) || defined(FASTMATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        fm_store(out + i, cos_kernel(fm_load(x + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = cos_kernel(x[i]);
+    }
+}
+
+void fast_atan2_n(const f32* y, const f32* x, f32* out, usize count) {
+    usize i = 0;
+#if defined(FASTMATH_SSE) || defined(FASTMATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        fm_store(out + i, atan2_kernel(fm_load(y + i), fm_load(x + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = atan2_kernel(y[i], x[i]);
+    }
+}
+
+void fast_exp_n(const f32* x, f32* out, usize count) {
+    usize i = 0;
+#if defined(FASTMATH_SSE) || defined(FASTMATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        fm_store(out + i, exp_kernel(fm_load(x + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = exp_kernel(x[i]);
+    }
+}
+
+vec2 fast_normalized(const vec2& v) {
+    f32 len_sq = v.length_squared();
+    return len_sq > 0 ? v * fast_rsqrt(len_sq) : vec2(0, 0);
+}
+
+vec3 fast_normalized(const vec3& v) {
+    f32 len_sq = v.length_squared();
+    return len_sq > 0 ? v * fast_rsqrt(len_sq) : vec3(0, 0, 0);
+}
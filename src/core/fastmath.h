@@ -0,0 +1,40 @@
+#pragma once
+
+#include "core/math3d.h"
+#include "core/types.h"
+
+// Opt-in approximations of libm functions, for bulk work (particles, many
+// normalizations) where full precision is not needed. Every function has a
+// scalar form and a batch form over float arrays; the batch forms run 4
+// lanes at a time on SSE2/NEON and share the scalar algorithm, so both have
+// the same error bounds. Bounds below are against libm in double precision
+// over the stated input range; src/tools/fastmath_bench sweeps each range
+// and fails if one is exceeded.
+//
+//   fast_rsqrt    relative error < 5e-6,     x in (FLT_MIN, FLT_MAX)
+//   fast_sin/cos  absolute error < 5e-7,     |x| <= 1e4 (grows with |x|)
+//   fast_atan2    absolute error < 3e-6 rad, any finite (y, x); (0, +-0) gives 0
+//   fast_exp      relative error < 1e-7,     x in [-87, 88], clamped outside
+//
+// The speedups are in the batch forms. The scalar forms exist for the
+// tails of the batch loops and for single values that must agree with a
+// batch result; they are not a faster libm. Per call, fast_sin, fast_cos
+// and fast_atan2 still beat libm by about 2-4x. fast_rsqrt measures about
+// 1.1x 1/sqrtf, and fast_exp about 0.9x expf, so it is slower. Prefer
+// libm for lone rsqrt and exp calls.
+
+f32 fast_rsqrt(f32 x);
+f32 fast_sin(f32 x);
+f32 fast_cos(f32 x);
+f32 fast_atan2(f32 y, f32 x);
+f32 fast_exp(f32 x);
+
+void fast_rsqrt_n(const f32* x, f32* out, usize count);
+void fast_sin_n(const f32* x, f32* out, usize count);
+void fast_cos_n(const f32* x, f32* out, usize count);
+void fast_atan2_n(const f32* y, const f32* x, f32* out, usize count);
+void fast_exp_n(const f32* x, f32* out, usize count);
+
+// Normalization through fast_rsqrt; zero vectors come back as zero
+vec2 fast_normalized(const vec2& v);
+vec3 fast_normalized(const vec3& v);
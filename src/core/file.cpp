@@ -1,6 +1,23 @@
 #include "core/file.h"
+#include "core/virtual_memory.h"
 #include <SDL3/SDL.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#elif defined(__APPLE__)
+#include <copyfile.h>
+#endif
+#endif
+
 /**
  * @brief Gets the last modification timestamp of a file.
  * @param path The path to the file.
@@ -99,39 +116,322 @@ void write_file(const char* path, const char* data, usize size) {
     SDL_CloseIO(file);
 }
 
+#ifndef _WIN32
+/**
+ * @brief Converts a stat modification time to the units of
+ * file_get_timestamp (nanoseconds since the epoch).
+ */
+static u64 file_stat_modify_time(const struct stat& st) {
+#ifdef __APPLE__
+    return (u64)st.st_mtimespec.tv_sec * 1000000000ull + (u64)st.st_mtimespec.tv_nsec;
+#else
+    return (u64)st.st_mtim.tv_sec * 1000000000ull + (u64)st.st_mtim.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Copies `size` bytes between two open files without passing them
+ * through user memory where the OS allows it.
+ * @return The number of bytes copied.
+ */
+static u64 file_copy_contents(int src_fd, int dst_fd, u64 size) {
+    u64 copied = 0;
+#if defined(__linux__)
+    // Clones the extents on filesystems with reflinks (btrfs, XFS), and
+    // copies inside the page cache elsewhere
+    while (copied < size) {
+        ssize_t n = copy_file_range(src_fd, nullptr, dst_fd, nullptr, (usize)(size - copied), 0);
+        if (n <= 0) break;
+        copied += (u64)n;
+    }
+    // Older kernels refuse some filesystem pairs; sendfile still stays in
+    // the kernel
+    while (copied < size) {
+        ssize_t n = sendfile(dst_fd, src_fd, nullptr, (usize)(size - copied));
+        if (n <= 0) break;
+        copied += (u64)n;
+    }
+#elif defined(__APPLE__)
+    if (fcopyfile(src_fd, dst_fd, nullptr, COPYFILE_DATA) == 0) {
+        copied = size;
+    }
+#else
+    u8 chunk[KB(64)];
+    while (copied < size) {
+        ssize_t n = ::read(src_fd, chunk, sizeof(chunk));
+        if (n <= 0 || ::write(dst_fd, chunk, (usize)n) != n) break;
+        copied += (u64)n;
+    }
+#endif
+    return copied;
+}
+#endif
+
 /**
- * @brief Copies a file from a source path to a destination path.
- * @param arena A pointer to a memory arena used for the temporary read buffer.
+ * @brief Copies a file by letting the OS move the bytes, then swaps the copy
+ * into place.
+ *
+ * The copy is made next to `dst_path` and only renamed over it when it is
+ * complete: every byte arrived and the source kept the same size and
+ * modification time from start to finish. A source that is still being
+ * written, such as a library the linker has not finished, fails the check
+ * and leaves `dst_path` untouched.
+ *
  * @param src_path The source file path.
  * @param dst_path The destination file path.
- * @return True on success, false on failure.
+ * @param info If not null, receives the size and modification time of the
+ * copied source.
+ * @return True if a complete copy is at `dst_path`, false otherwise.
  */
-bool copy_file(Arena* arena, const char* src_path, const char* dst_path) {
-    usize size = file_get_size(src_path);
-    // Check if the source exists and is not an empty file we can't read.
-    if (size == 0 && !file_exists(src_path)) {
+bool copy_file(const char* src_path, const char* dst_path, FileCopyInfo* info) {
+    char tmp_path[1024];
+    i32 length = SDL_snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", dst_path);
+    if (length < 0 || length >= (i32)sizeof(tmp_path)) {
+        SDL_Log("Copy destination path too long: '%s'", dst_path);
+        return false;
+    }
+
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA before, after;
+    if (!GetFileAttributesExA(src_path, GetFileExInfoStandard, &before)) {
         SDL_Log("Source file for copy does not exist: '%s'", src_path);
         return false;
     }
-    
-    // An empty file can be "copied" by creating an empty destination file.
-    if (size == 0) {
-        write_file(dst_path, "", 0);
-        return file_exists(dst_path);
+    bool complete = CopyFileA(src_path, tmp_path, FALSE) &&
+                    GetFileAttributesExA(src_path, GetFileExInfoStandard, &after) &&
+                    before.nFileSizeLow == after.nFileSizeLow &&
+                    before.nFileSizeHigh == after.nFileSizeHigh &&
+                    CompareFileTime(&before.ftLastWriteTime, &after.ftLastWriteTime) == 0;
+    if (!complete || !MoveFileExA(tmp_path, dst_path, MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(tmp_path);
+        return false;
+    }
+    if (info) {
+        info->size = ((u64)before.nFileSizeHigh << 32) | before.nFileSizeLow;
+        info->modify_time = (u64)SDL_TimeFromWindows(
+            before.ftLastWriteTime.dwLowDateTime,
+            before.ftLastWriteTime.dwHighDateTime
+        );
+    }
+    return true;
+#else
+    int src_fd = ::open(src_path, O_RDONLY | O_CLOEXEC);
+    if (src_fd < 0) {
+        SDL_Log("Source file for copy does not exist: '%s'", src_path);
+        return false;
     }
 
-    char* data = read_entire_file(arena, src_path);
-    if (!data) {
+    struct stat before, after;
+    int dst_fd = -1;
+    if (fstat(src_fd, &before) == 0) {
+        dst_fd = ::open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, before.st_mode & 0777);
+    }
+    if (dst_fd < 0) {
+        SDL_Log("Failed to create '%s': %s", tmp_path, strerror(errno));
+        ::close(src_fd);
         return false;
     }
 
-    write_file(dst_path, data, size);
+    u64 copied = file_copy_contents(src_fd, dst_fd, (u64)before.st_size);
+    bool complete = ::close(dst_fd) == 0 && copied == (u64)before.st_size &&
+                    fstat(src_fd, &after) == 0 && after.st_size == before.st_size &&
+                    file_stat_modify_time(after) == file_stat_modify_time(before);
+    ::close(src_fd);
+    if (!complete || rename(tmp_path, dst_path) != 0) {
+        unlink(tmp_path);
+        return false;
+    }
+    if (info) {
+        info->size = (u64)before.st_size;
+        info->modify_time = file_stat_modify_time(before);
+    }
+    return true;
+#endif
+}
+
+// Stand-in mapping for empty files, which the OS refuses to map
+static const u8 file_view_empty[1] = {0};
+
+FileView::~FileView() {
+    close();
+}
 
-    // Verify the copy was successful by checking the destination file's size.
-    if (file_get_size(dst_path) != size) {
-        SDL_Log("Copy failed: Destination file size mismatch for '%s'", dst_path);
+FileView::FileView(FileView&& other)
+    : data(other.data), size(other.size), mapping(other.mapping),
+      opened(other.opened) {
+    other.data = nullptr;
+    other.size = 0;
+    other.mapping = nullptr;
+    other.opened = false;
+}
+
+FileView& FileView::operator=(FileView&& other) {
+    if (this != &other) {
+        close();
+        data = other.data;
+        size = other.size;
+        mapping = other.mapping;
+        opened = other.opened;
+        other.data = nullptr;
+        other.size = 0;
+        other.mapping = nullptr;
+        other.opened = false;
+    }
+    return *this;
+}
+
+/**
+ * @brief Maps a file read-only into memory.
+ *
+ * The file handle is closed right after mapping; the mapping keeps the file
+ * contents alive on its own.
+ *
+ * @param path The path to the file.
+ * @return True on success, false if the file could not be opened or mapped.
+ */
+bool FileView::open(const char* path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        SDL_Log("Failed to open file for mapping '%s': error %lu", path, GetLastError());
         return false;
     }
 
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        SDL_Log("Failed to get size of file '%s': error %lu", path, GetLastError());
+        CloseHandle(file);
+        return false;
+    }
+
+    void* base = nullptr;
+    if (file_size.QuadPart > 0) {
+        HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (section) {
+            base = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(section);
+        }
+        if (!base) {
+            SDL_Log("Failed to map file '%s': error %lu", path, GetLastError());
+            CloseHandle(file);
+            return false;
+        }
+    }
+    CloseHandle(file);
+    usize mapped_size = (usize)file_size.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        SDL_Log("Failed to open file for mapping '%s': %s", path, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        SDL_Log("Failed to get size of file '%s': %s", path, strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* base = nullptr;
+    if (st.st_size > 0) {
+        base = mmap(nullptr, (usize)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            SDL_Log("Failed to map file '%s': %s", path, strerror(errno));
+            ::close(fd);
+            return false;
+        }
+    }
+    ::close(fd);
+    usize mapped_size = (usize)st.st_size;
+#endif
+
+    mapping = base;
+    data = base ? (const u8*)base : file_view_empty;
+    size = mapped_size;
+    opened = true;
     return true;
 }
+
+/**
+ * @brief Unmaps the file. Safe to call on a view that is not open.
+ */
+void FileView::close() {
+    if (mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+#else
+        munmap(mapping, size);
+#endif
+    }
+    mapping = nullptr;
+    data = nullptr;
+    size = 0;
+    opened = false;
+}
+
+bool FileView::is_open() const {
+    return opened;
+}
+
+/**
+ * @brief Passes an access pattern hint for part of the mapping to the OS.
+ *
+ * The range is widened to whole pages. On Windows only FILE_ADVICE_WILLNEED
+ * has an equivalent (PrefetchVirtualMemory); the other hints are ignored.
+ *
+ * @param advice The expected access pattern.
+ * @param offset Start of the range in bytes.
+ * @param length Length of the range in bytes, 0 for the rest of the file.
+ */
+void FileView::advise(FileAdvice advice, usize offset, usize length) {
+    if (!mapping || offset >= size) return;
+    if (length == 0 || length > size - offset) {
+        length = size - offset;
+    }
+
+    usize page_size = vm_page_size();
+    usize start = offset & ~(page_size - 1);
+    length += offset - start;
+
+#ifdef _WIN32
+    if (advice == FILE_ADVICE_WILLNEED) {
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = (u8*)mapping + start;
+        range.NumberOfBytes = length;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    int hint = MADV_NORMAL;
+    switch (advice) {
+        case FILE_ADVICE_NORMAL:
+            hint = MADV_NORMAL;
+            break;
+        case FILE_ADVICE_SEQUENTIAL:
+            hint = MADV_SEQUENTIAL;
+            break;
+        case FILE_ADVICE_RANDOM:
+            hint = MADV_RANDOM;
+            break;
+        case FILE_ADVICE_WILLNEED:
+            hint = MADV_WILLNEED;
+            break;
+        case FILE_ADVICE_DONTNEED:
+            hint = MADV_DONTNEED;
+            break;
+    }
+    if (madvise((u8*)mapping + start, length, hint) != 0) {
+        SDL_Log("madvise failed on file view: %s", strerror(errno));
+    }
+#endif
+}
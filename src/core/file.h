@@ -8,4 +8,55 @@ bool file_exists(const char* path);
 usize file_get_size(const char* path);
 char* read_entire_file(Arena* arena, const char* path);
 void write_file(const char* path, const char* data, usize size);
-bool copy_file(Arena* arena, const char* src_path, const char* dst_path);
+
+struct FileCopyInfo {
+    u64 size;
+    u64 modify_time; // Same units as file_get_timestamp
+};
+
+// CopyFile: Copies `src_path` to `dst_path` inside the kernel (reflinks,
+// copy_file_range or sendfile on Linux) and atomically renames the result
+// into place. Fails, leaving `dst_path` alone, if the source changed during
+// the copy.
+bool copy_file(const char* src_path, const char* dst_path, FileCopyInfo* info = nullptr);
+
+// Access pattern hints for FileView::advise
+enum FileAdvice {
+    FILE_ADVICE_NORMAL,
+    FILE_ADVICE_SEQUENTIAL, // Read front to back; read ahead aggressively
+    FILE_ADVICE_RANDOM,     // Scattered reads; skip read-ahead
+    FILE_ADVICE_WILLNEED,   // Start paging the range in now
+    FILE_ADVICE_DONTNEED,   // Done with the range; its pages may be dropped
+};
+
+// Read-only memory mapping of a whole file. Pages are loaded on first touch
+// straight from the page cache, so nothing is copied or pushed into an
+// arena. The mapping is released by close() or when the view goes out of
+// scope; a view that lives in a long-lived struct is closed by that
+// struct's cleanup.
+struct FileView {
+    const u8* data{};
+    usize size{};
+
+    FileView() {}
+    ~FileView();
+
+    FileView(FileView&& other);
+    FileView& operator=(FileView&& other);
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+
+    // Open: Maps `path`, replacing any previous mapping. Returns false on
+    // failure. An empty file gives size 0 and a valid, non-null data.
+    bool open(const char* path);
+    void close();
+    bool is_open() const;
+
+    // Advise: Hints how [offset, offset + length) will be read; length 0
+    // means up to the end. Ignored where the OS has no matching hint.
+    void advise(FileAdvice advice, usize offset = 0, usize length = 0);
+
+  private:
+    void* mapping{}; // Base of the OS mapping, nullptr for empty files
+    bool opened{};
+};
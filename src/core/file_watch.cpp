@@ -0,0 +1,380 @@
+#include "core/file_watch.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define FILE_WATCH_INOTIFY
+#endif
+
+// How often the polling backend rescans; a change is reported on the scan
+// after the one that saw it, once it held still
+#define FILE_WATCH_POLL_INTERVAL_MS 250
+
+#if defined(FILE_WATCH_INOTIFY)
+// Written and closed, or renamed into place: both mean the file is whole
+#define FILE_WATCH_INOTIFY_MASK (IN_CLOSE_WRITE | IN_MOVED_TO)
+#endif
+
+/**
+ * @brief Splits `path` into the directory to watch and the file name to
+ * match in it; a directory path matches every name.
+ * @return False if the path is too long.
+ */
+static bool file_watch_split(const char* path, FileWatchEntry* entry) {
+    // A missing path is taken to be a file that is yet to be created
+    SDL_PathInfo info{};
+    if (SDL_GetPathInfo(path, &info) && info.type == SDL_PATHTYPE_DIRECTORY) {
+        entry->name[0] = '\0';
+        return SDL_strlcpy(entry->dir, path, sizeof(entry->dir)) < sizeof(entry->dir);
+    }
+
+    const char* slash = SDL_strrchr(path, '/');
+#ifdef _WIN32
+    const char* backslash = SDL_strrchr(path, '\\');
+    if (backslash > slash) slash = backslash;
+#endif
+    if (!slash) {
+        SDL_strlcpy(entry->dir, ".", sizeof(entry->dir));
+        return SDL_strlcpy(entry->name, path, sizeof(entry->name)) < sizeof(entry->name);
+    }
+
+    usize dir_length = (usize)(slash - path);
+    if (dir_length >= sizeof(entry->dir)) return false;
+    SDL_memcpy(entry->dir, path, dir_length);
+    entry->dir[dir_length] = '\0';
+    return SDL_strlcpy(entry->name, slash + 1, sizeof(entry->name)) < sizeof(entry->name);
+}
+
+static SDL_EnumerationResult SDLCALL file_watch_scan_file(void* userdata, const char* dirname, const char* fname) {
+    char path[FILE_WATCH_MAX_PATH * 2];
+    SDL_snprintf(path, sizeof(path), "%s%s", dirname, fname);
+
+    SDL_PathInfo info{};
+    if (SDL_GetPathInfo(path, &info) && info.type == SDL_PATHTYPE_FILE) {
+        u64* stamp = (u64*)userdata;
+        *stamp = SDL_max(*stamp, (u64)info.modify_time);
+    }
+    return SDL_ENUM_CONTINUE;
+}
+
+/**
+ * @brief Latest modification time of a watched file, or of any file in a
+ * watched directory. Used by the polling backend.
+ */
+static u64 file_watch_scan(const FileWatchEntry& entry) {
+    u64 stamp = 0;
+    if (entry.name[0] == '\0') {
+        SDL_PathInfo info{};
+        if (SDL_GetPathInfo(entry.dir, &info)) {
+            stamp = (u64)info.modify_time; // Catches removals
+        }
+        SDL_EnumerateDirectory(entry.dir, file_watch_scan_file, &stamp);
+        return stamp;
+    }
+
+    char path[FILE_WATCH_MAX_PATH * 2];
+    SDL_snprintf(path, sizeof(path), "%s/%s", entry.dir, entry.name);
+    SDL_PathInfo info{};
+    if (SDL_GetPathInfo(path, &info)) {
+        stamp = (u64)info.modify_time;
+    }
+    return stamp;
+}
+
+/**
+ * @brief Registers the notification event and starts the watcher thread,
+ * on inotify when the kernel provides it and on rescans otherwise.
+ * @param settle_ms How long a watch must stay quiet before it is reported.
+ * @return True on success, false otherwise.
+ */
+bool FileWatcher::init(u32 settle_ms) {
+    backend = FILE_WATCH_BACKEND_NONE;
+    this->settle_ms = settle_ms;
+    entry_count = 0;
+    thread = nullptr;
+    wake = nullptr;
+    notify_fd = -1;
+    wake_fd = -1;
+    quitting = false;
+
+    event_type = SDL_RegisterEvents(1);
+    mutex = SDL_CreateMutex();
+    if (event_type == 0 || !mutex) {
+        SDL_Log("Failed to set up file watcher: %s", SDL_GetError());
+        shutdown();
+        return false;
+    }
+
+#if defined(FILE_WATCH_INOTIFY)
+    notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (notify_fd >= 0 && wake_fd >= 0) {
+        backend = FILE_WATCH_BACKEND_INOTIFY;
+    } else {
+        SDL_Log("inotify unavailable, watching files by polling");
+        if (notify_fd >= 0) close(notify_fd);
+        if (wake_fd >= 0) close(wake_fd);
+        notify_fd = -1;
+        wake_fd = -1;
+    }
+#endif
+
+    if (backend == FILE_WATCH_BACKEND_NONE) {
+        wake = SDL_CreateCondition();
+        if (!wake) {
+            SDL_Log("Failed to set up file watcher: %s", SDL_GetError());
+            shutdown();
+            return false;
+        }
+        backend = FILE_WATCH_BACKEND_POLLING;
+    }
+
+    thread = SDL_CreateThread(run, "file_watch", this);
+    if (!thread) {
+        SDL_Log("Failed to start file watcher: %s", SDL_GetError());
+        shutdown();
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::shutdown() {
+    if (thread) {
+        SDL_LockMutex(mutex);
+        quitting = true;
+        if (wake) SDL_SignalCondition(wake);
+        SDL_UnlockMutex(mutex);
+#if defined(FILE_WATCH_INOTIFY)
+        if (wake_fd >= 0) {
+            u64 one = 1;
+            [[maybe_unused]] ssize_t written = write(wake_fd, &one, sizeof(one));
+        }
+#endif
+        SDL_WaitThread(thread, nullptr);
+        thread = nullptr;
+    }
+
+#if defined(FILE_WATCH_INOTIFY)
+    if (notify_fd >= 0) close(notify_fd);
+    if (wake_fd >= 0) close(wake_fd);
+#endif
+    notify_fd = -1;
+    wake_fd = -1;
+
+    if (wake) SDL_DestroyCondition(wake);
+    if (mutex) SDL_DestroyMutex(mutex);
+    wake = nullptr;
+    mutex = nullptr;
+    backend = FILE_WATCH_BACKEND_NONE;
+}
+
+/**
+ * @brief Starts reporting writes to a file or a directory's files.
+ * @param path File or directory to watch.
+ * @param tag Copied into `event.user.code` of the notifications.
+ * @return True on success, false if the path or its directory is missing,
+ * the path is too long, or the watch table is full.
+ */
+bool FileWatcher::watch(const char* path, i32 tag) {
+    DEBUG_ASSERT(backend != FILE_WATCH_BACKEND_NONE, "FileWatcher used before init");
+
+    FileWatchEntry entry{};
+    entry.tag = tag;
+    entry.wd = -1;
+    if (!file_watch_split(path, &entry)) {
+        return false;
+    }
+
+#if defined(FILE_WATCH_INOTIFY)
+    if (backend == FILE_WATCH_BACKEND_INOTIFY) {
+        // A directory watched twice shares its descriptor
+        entry.wd = inotify_add_watch(notify_fd, entry.dir, FILE_WATCH_INOTIFY_MASK);
+        if (entry.wd < 0) {
+            SDL_Log("Cannot watch '%s': %s", path, strerror(errno));
+            return false;
+        }
+    }
+#endif
+    if (backend == FILE_WATCH_BACKEND_POLLING) {
+        entry.stamp = file_watch_scan(entry);
+    }
+
+    SDL_LockMutex(mutex);
+    bool added = entry_count < FILE_WATCH_MAX_WATCHES;
+    if (added) {
+        entries[entry_count++] = entry;
+    }
+    SDL_UnlockMutex(mutex);
+
+    if (!added) {
+        SDL_Log("Cannot watch '%s': all %d watches in use", path, FILE_WATCH_MAX_WATCHES);
+    }
+    return added;
+}
+
+u32 FileWatcher::get_event_type() const {
+    return event_type;
+}
+
+FileWatchBackend FileWatcher::get_backend() const {
+    return backend;
+}
+
+int FileWatcher::run(void* data) {
+    FileWatcher* watcher = (FileWatcher*)data;
+    if (watcher->backend == FILE_WATCH_BACKEND_INOTIFY) {
+        watcher->run_inotify();
+    } else {
+        watcher->run_polling();
+    }
+    return 0;
+}
+
+/**
+ * @brief Pushes one event per watch whose bit is set in `dirty_mask`. Tags
+ * are copied under the mutex, since watch() may be filling the table.
+ */
+void FileWatcher::publish(u32 dirty_mask) {
+    i32 tags[FILE_WATCH_MAX_WATCHES];
+    u32 tag_count = 0;
+    SDL_LockMutex(mutex);
+    for (u32 i = 0; dirty_mask != 0; i++, dirty_mask >>= 1) {
+        if (dirty_mask & 1) {
+            tags[tag_count++] = entries[i].tag;
+        }
+    }
+    SDL_UnlockMutex(mutex);
+
+    for (u32 i = 0; i < tag_count; i++) {
+        SDL_Event event{};
+        event.type = event_type;
+        event.user.code = tags[i];
+        if (!SDL_PushEvent(&event)) {
+            SDL_Log("Failed to publish file change: %s", SDL_GetError());
+        }
+    }
+}
+
+/**
+ * @brief Watcher thread on inotify. Sleeps in poll() until the kernel has
+ * events or shutdown wakes it, and only while a change is settling does it
+ * wake on a timeout.
+ */
+void FileWatcher::run_inotify() {
+#if defined(FILE_WATCH_INOTIFY)
+    alignas(inotify_event) char buffer[4096];
+    u32 dirty = 0;
+    // Per watch, so a burst on one file does not hold back another's report
+    u64 settle_deadlines[FILE_WATCH_MAX_WATCHES] = {};
+
+    for (;;) {
+        i32 timeout = -1;
+        if (dirty != 0) {
+            u64 now = SDL_GetTicks();
+            u64 next_deadline = UINT64_MAX;
+            for (u32 i = 0; i < FILE_WATCH_MAX_WATCHES; i++) {
+                if (dirty & (1u << i)) {
+                    next_deadline = SDL_min(next_deadline, settle_deadlines[i]);
+                }
+            }
+            timeout = next_deadline > now ? (i32)(next_deadline - now) : 0;
+        }
+
+        pollfd fds[2] = {
+            {notify_fd, POLLIN, 0},
+            {wake_fd, POLLIN, 0},
+        };
+        i32 ready = poll(fds, 2, timeout);
+        if (ready < 0 && errno != EINTR) {
+            SDL_Log("File watcher stopped: %s", strerror(errno));
+            break;
+        }
+        if (fds[1].revents != 0) {
+            break;
+        }
+
+        if (fds[0].revents != 0) {
+            u32 matched = 0;
+            ssize_t length;
+            SDL_LockMutex(mutex);
+            while ((length = read(notify_fd, buffer, sizeof(buffer))) > 0) {
+                for (char* at = buffer; at < buffer + length;) {
+                    const inotify_event* event = (const inotify_event*)at;
+                    at += sizeof(inotify_event) + event->len;
+
+                    const char* name = event->len ? event->name : "";
+                    for (u32 i = 0; i < entry_count; i++) {
+                        const FileWatchEntry& entry = entries[i];
+                        if (entry.wd == event->wd &&
+                            (entry.name[0] == '\0' || SDL_strcmp(entry.name, name) == 0)) {
+                            matched |= 1u << i;
+                        }
+                    }
+                }
+            }
+            SDL_UnlockMutex(mutex);
+
+            // Each write to a watched file pushes its report back, so a
+            // burst is reported once it ends. Other watches, and unrelated
+            // files in the same directory, do not delay it.
+            u64 deadline = SDL_GetTicks() + settle_ms;
+            dirty |= matched;
+            for (u32 i = 0; matched != 0; i++, matched >>= 1) {
+                if (matched & 1) {
+                    settle_deadlines[i] = deadline;
+                }
+            }
+        }
+
+        u32 settled = 0;
+        u64 now = SDL_GetTicks();
+        for (u32 i = 0; i < FILE_WATCH_MAX_WATCHES; i++) {
+            if ((dirty & (1u << i)) && now >= settle_deadlines[i]) {
+                settled |= 1u << i;
+            }
+        }
+        if (settled != 0) {
+            publish(settled);
+            dirty &= ~settled;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Watcher thread without OS notifications. Rescans every watch on an
+ * interval and reports one whose time moved on the previous scan and held
+ * still on this one.
+ */
+void FileWatcher::run_polling() {
+    SDL_LockMutex(mutex);
+    while (!quitting) {
+        SDL_WaitConditionTimeout(wake, mutex, FILE_WATCH_POLL_INTERVAL_MS);
+        if (quitting) break;
+
+        u32 dirty = 0;
+        for (u32 i = 0; i < entry_count; i++) {
+            FileWatchEntry& entry = entries[i];
+            u64 stamp = file_watch_scan(entry);
+            if (stamp != entry.stamp) {
+                entry.stamp = stamp;
+                entry.changing = true;
+            } else if (entry.changing) {
+                entry.changing = false;
+                dirty |= 1u << i;
+            }
+        }
+
+        SDL_UnlockMutex(mutex);
+        publish(dirty);
+        SDL_LockMutex(mutex);
+    }
+    SDL_UnlockMutex(mutex);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/types.h"
+
+#define FILE_WATCH_MAX_WATCHES 16
+#define FILE_WATCH_MAX_PATH 512
+
+enum FileWatchBackend {
+    FILE_WATCH_BACKEND_NONE,
+    FILE_WATCH_BACKEND_INOTIFY,
+    FILE_WATCH_BACKEND_POLLING,
+};
+
+struct FileWatchEntry {
+    char dir[FILE_WATCH_MAX_PATH];
+    char name[FILE_WATCH_MAX_PATH]; // Empty when the whole directory is watched
+    i32 tag;
+    i32 wd;        // inotify watch descriptor
+    u64 stamp;     // Polling only: latest modification time seen
+    bool changing; // Polling only: stamp moved on the last scan
+};
+
+struct SDL_Thread;
+struct SDL_Mutex;
+struct SDL_Condition;
+
+// Reports changes to files and directories without the frame loop asking.
+// A background thread sleeps on inotify (Linux) or, elsewhere, rescans the
+// watched paths a few times a second. Writes are coalesced: a watch is only
+// reported once its files have been quiet for `settle_ms`, so a linker or
+// packer writing in many steps produces one notification.
+//
+// Notifications arrive as SDL events of type get_event_type() with the
+// watch's tag in `event.user.code`, so they are picked up by the event pump
+// the frame loop already runs.
+struct FileWatcher {
+    // Init: Starts the watcher thread. Returns false on failure.
+    bool init(u32 settle_ms = 50);
+    // Shutdown: Stops the thread; no events are pushed after it returns
+    void shutdown();
+
+    // Watch: Reports writes to `path`, or to any file directly inside it
+    // when it is a directory, as events carrying `tag`. Files replaced by
+    // rename count as written, and a file may be watched before it exists.
+    // Returns false if the path cannot be watched.
+    bool watch(const char* path, i32 tag);
+
+    u32 get_event_type() const;
+    FileWatchBackend get_backend() const;
+
+  private:
+    FileWatchBackend backend{};
+    u32 event_type{};
+    u32 settle_ms{};
+    FileWatchEntry entries[FILE_WATCH_MAX_WATCHES]{};
+    u32 entry_count{};
+    SDL_Mutex* mutex{};       // Guards entries against watch() from the frame thread
+    SDL_Condition* wake{};    // Polling only: signalled to stop the thread
+    SDL_Thread* thread{};
+    i32 notify_fd{-1};        // inotify only
+    i32 wake_fd{-1};          // inotify only: eventfd that stops the thread
+    bool quitting{};
+
+    static int run(void* data);
+    void run_inotify();
+    void run_polling();
+    void publish(u32 dirty_mask);
+};
@@ -0,0 +1,76 @@
+#include "core/fixed_array.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, usize N> FixedArray<T, N>::~FixedArray() {
+    clear();
+}
+
+template <typename T, usize N> T* FixedArray<T, N>::data() {
+    return (T*)storage;
+}
+
+template <typename T, usize N> const T* FixedArray<T, N>::data() const {
+    return (const T*)storage;
+}
+
+template <typename T, usize N> T& FixedArray<T, N>::operator[](usize idx) {
+    DEBUG_ASSERT(idx < size, "FixedArray access out of bounds");
+    return data()[idx];
+}
+
+template <typename T, usize N> usize FixedArray<T, N>::push(const T& item) {
+    DEBUG_ASSERT(size < N, "FixedArray full");
+    new (data() + size) T(item);
+    return size++;
+}
+
+template <typename T, usize N> T FixedArray<T, N>::pop() {
+    DEBUG_ASSERT(size > 0, "FixedArray is empty");
+    T* last = data() + --size;
+    T item = std::move(*last);
+    last->~T();
+    return item;
+}
+
+template <typename T, usize N>
+void FixedArray<T, N>::push_n(const T* src, usize count) {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "FixedArray::push_n copies with memcpy"
+    );
+    if (count == 0) return;
+    SDL_memcpy(resize_uninit(count), src, sizeof(T) * count);
+}
+
+template <typename T, usize N> T* FixedArray<T, N>::resize_uninit(usize count) {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "FixedArray::resize_uninit skips construction"
+    );
+    DEBUG_ASSERT(size + count <= N, "FixedArray full");
+    T* first = data() + size;
+    size += count;
+    return first;
+}
+
+template <typename T, usize N> void FixedArray<T, N>::clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (usize i = 0; i < size; i++) {
+            data()[i].~T();
+        }
+    }
+    size = 0;
+}
+
+template <typename T, usize N> bool FixedArray<T, N>::is_full() {
+    return size == N;
+}
+
+template <typename T, usize N> bool FixedArray<T, N>::is_empty() {
+    return size == 0;
+}
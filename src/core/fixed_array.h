@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/types.h"
+
+// Fixed-capacity array over raw aligned storage. Unlike Array, nothing is
+// constructed (or zeroed) up front: elements come to life on push, so a
+// large FixedArray costs no page faults until it is actually filled. For
+// trivially copyable T, push_n and resize_uninit append in bulk without
+// per-element construction.
+template <typename T, usize N> struct FixedArray {
+    static constexpr usize capacity = N;
+    usize size{};
+
+    // User-provided so `FixedArray<...> x{}` does not zero the storage
+    FixedArray() {}
+    FixedArray(const FixedArray&) = delete;
+    FixedArray& operator=(const FixedArray&) = delete;
+    ~FixedArray();
+
+    T* data();
+    const T* data() const;
+    T& operator[](usize idx);
+    usize push(const T& item);
+    T pop();
+    // PushN: Appends `count` items copied from `src` with a single memcpy.
+    void push_n(const T* src, usize count);
+    // ResizeUninit: Grows the array by `count` items left uninitialized for
+    // the caller to fill, returning a pointer to the first one.
+    T* resize_uninit(usize count);
+    void clear();
+    bool is_full();
+    bool is_empty();
+
+  private:
+    alignas(T) u8 storage[sizeof(T) * N];
+};
@@ -0,0 +1,258 @@
+#include "core/hash_map.h"
+#include "core/assert.h"
+#include "core/utils.h"
+
+#include <SDL3/SDL.h>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HASH_MAP_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HASH_MAP_NEON
+#endif
+
+#define HASH_CTRL_EMPTY 0x80
+#define HASH_CTRL_DELETED 0xFE
+
+static inline u64 hash_rotl(u64 value, u32 bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ * @brief Mixes all bits of a 64-bit value (murmur3 finalizer).
+ */
+u64 hash_u64(u64 value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @brief Hashes a byte range eight bytes at a time.
+ * @param data Bytes to hash.
+ * @param size Number of bytes.
+ * @return 64-bit hash, suitable for hash tables but not for security.
+ */
+u64 hash_bytes(const void* data, usize size) {
+    const u8* bytes = (const u8*)data;
+    u64 hash = 0x9e3779b97f4a7c15ull ^ (size * 0x87c37b91114253d5ull);
+
+    while (size >= 8) {
+        u64 word;
+        SDL_memcpy(&word, bytes, 8);
+        hash = hash_rotl(hash ^ (word * 0x87c37b91114253d5ull), 31);
+        hash *= 0x4cf5ad432745937full;
+        bytes += 8;
+        size -= 8;
+    }
+
+    u64 tail = 0;
+    SDL_memcpy(&tail, bytes, size);
+    hash ^= tail * 0x87c37b91114253d5ull;
+
+    return hash_u64(hash);
+}
+
+u64 hash_key(u32 key) {
+    return hash_u64(key);
+}
+
+u64 hash_key(u64 key) {
+    return hash_u64(key);
+}
+
+u64 hash_key(i32 key) {
+    return hash_u64((u32)key);
+}
+
+u64 hash_key(std::string_view key) {
+    return hash_bytes(key.data(), key.size());
+}
+
+// Bitmask with one bit per control byte of `group` equal to `value`
+static inline u32 hash_group_match(const u8* group, u8 value) {
+#if defined(HASH_MAP_SSE2)
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+#elif defined(HASH_MAP_NEON)
+    uint8x16_t eq = vceqq_u8(vld1q_u8(group), vdupq_n_u8(value));
+    // Narrow each byte to a nibble, then keep one bit per nibble
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    u64 bits = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+    bits &= 0x8888888888888888ull;
+    u32 mask = 0;
+    while (bits) {
+        mask |= 1u << (__builtin_ctzll(bits) >> 2);
+        bits &= bits - 1;
+    }
+    return mask;
+#else
+    u32 mask = 0;
+    for (u32 i = 0; i < HASH_MAP_GROUP_WIDTH; i++) {
+        mask |= (u32)(group[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+template <typename K, typename V>
+HashMap<K, V>::HashMap(Arena* arena, usize initial_capacity) : arena(arena) {
+    static_assert(
+        std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>,
+        "HashMap keys and values are relocated with memcpy"
+    );
+
+    usize new_capacity = HASH_MAP_GROUP_WIDTH;
+    while (new_capacity < initial_capacity) {
+        new_capacity <<= 1;
+    }
+    allocate(new_capacity);
+}
+
+template <typename K, typename V> V* HashMap<K, V>::find(const K& key) {
+    if (count == 0) return nullptr;
+    Slot* slot = find_slot(key, hash_key(key));
+    return slot ? &slot->value : nullptr;
+}
+
+template <typename K, typename V>
+V* HashMap<K, V>::insert(const K& key, const V& value) {
+    DEBUG_ASSERT(ctrl != nullptr, "HashMap inserted into before construction with an arena");
+    u64 hash = hash_key(key);
+
+    Slot* existing = find_slot(key, hash);
+    if (existing) {
+        existing->value = value;
+        return &existing->value;
+    }
+
+    // Keep the load (including tombstones) under 7/8
+    if ((count + tombstones + 1) * 8 > capacity * 7) {
+        rehash(count * 2 + 2 > capacity ? capacity * 2 : capacity);
+    }
+
+    usize index = find_insert_index(hash);
+    if (ctrl[index] == HASH_CTRL_DELETED) {
+        tombstones--;
+    }
+    ctrl[index] = (u8)(hash & 0x7F);
+    slots[index].key = key;
+    slots[index].value = value;
+    count++;
+    return &slots[index].value;
+}
+
+template <typename K, typename V> bool HashMap<K, V>::remove(const K& key) {
+    if (count == 0) return false;
+
+    Slot* slot = find_slot(key, hash_key(key));
+    if (!slot) return false;
+
+    ctrl[slot - slots] = HASH_CTRL_DELETED;
+    count--;
+    tombstones++;
+    return true;
+}
+
+template <typename K, typename V> void HashMap<K, V>::clear() {
+    SDL_memset(ctrl, HASH_CTRL_EMPTY, capacity);
+    count = 0;
+    tombstones = 0;
+}
+
+template <typename K, typename V> usize HashMap<K, V>::get_count() {
+    return count;
+}
+
+template <typename K, typename V>
+template <typename F>
+void HashMap<K, V>::for_each(F&& f) {
+    for (usize i = 0; i < capacity; i++) {
+        if ((ctrl[i] & 0x80) == 0) {
+            f((const K&)slots[i].key, slots[i].value);
+        }
+    }
+}
+
+template <typename K, typename V>
+void HashMap<K, V>::allocate(usize new_capacity) {
+    DEBUG_ASSERT(arena != nullptr, "HashMap has no arena");
+    ctrl = arena->push_array<u8>(new_capacity, HASH_MAP_GROUP_WIDTH);
+    slots = arena->push_array<Slot>(new_capacity);
+    DEBUG_ASSERT(ctrl && slots, "HashMap failed to allocate its table");
+    SDL_memset(ctrl, HASH_CTRL_EMPTY, new_capacity);
+    capacity = new_capacity;
+    count = 0;
+    tombstones = 0;
+}
+
+template <typename K, typename V>
+void HashMap<K, V>::rehash(usize new_capacity) {
+    u8* old_ctrl = ctrl;
+    Slot* old_slots = slots;
+    usize old_capacity = capacity;
+
+    allocate(new_capacity);
+
+    for (usize i = 0; i < old_capacity; i++) {
+        if ((old_ctrl[i] & 0x80) == 0) {
+            u64 hash = hash_key(old_slots[i].key);
+            usize index = find_insert_index(hash);
+            ctrl[index] = (u8)(hash & 0x7F);
+            slots[index] = old_slots[i];
+            count++;
+        }
+    }
+}
+
+template <typename K, typename V>
+typename HashMap<K, V>::Slot* HashMap<K, V>::find_slot(const K& key, u64 hash) {
+    DEBUG_ASSERT(ctrl != nullptr, "HashMap probed before construction with an arena");
+    usize group_mask = capacity / HASH_MAP_GROUP_WIDTH - 1;
+    usize group = (hash >> 7) & group_mask;
+    u8 tag = (u8)(hash & 0x7F);
+
+    // Triangular probing visits every group once for power-of-two counts
+    for (usize probe = 0; probe <= group_mask; probe++) {
+        usize base = group * HASH_MAP_GROUP_WIDTH;
+        u32 matches = hash_group_match(ctrl + base, tag);
+        while (matches) {
+            usize index = base + __builtin_ctz(matches);
+            if (slots[index].key == key) {
+                return &slots[index];
+            }
+            matches &= matches - 1;
+        }
+
+        if (hash_group_match(ctrl + base, HASH_CTRL_EMPTY)) {
+            return nullptr;
+        }
+        group = (group + probe + 1) & group_mask;
+    }
+    return nullptr;
+}
+
+template <typename K, typename V>
+usize HashMap<K, V>::find_insert_index(u64 hash) {
+    usize group_mask = capacity / HASH_MAP_GROUP_WIDTH - 1;
+    usize group = (hash >> 7) & group_mask;
+
+    for (usize probe = 0; probe <= group_mask; probe++) {
+        usize base = group * HASH_MAP_GROUP_WIDTH;
+        // Empty and deleted are the only control bytes with the top bit set
+        u32 free_slots = hash_group_match(ctrl + base, HASH_CTRL_EMPTY) |
+                         hash_group_match(ctrl + base, HASH_CTRL_DELETED);
+        if (free_slots) {
+            return base + __builtin_ctz(free_slots);
+        }
+        group = (group + probe + 1) & group_mask;
+    }
+
+    DEBUG_ASSERT(false, "HashMap has no free slot");
+    unreachable;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+
+#include <string_view>
+
+// Control bytes are inspected 16 at a time (one SSE2/NEON register)
+#define HASH_MAP_GROUP_WIDTH 16
+
+// Fast non-cryptographic hashes
+u64 hash_u64(u64 value);
+u64 hash_bytes(const void* data, usize size);
+
+// Key hashing used by HashMap; add overloads for new key types
+u64 hash_key(u32 key);
+u64 hash_key(u64 key);
+u64 hash_key(i32 key);
+u64 hash_key(std::string_view key);
+
+// Open-addressing hash map in the SwissTable layout: one control byte per
+// slot holding 7 bits of the hash (or an empty/deleted marker), probed a
+// group of 16 at a time with SIMD compares. Storage comes from an arena and
+// is abandoned to it when the table grows. Keys and values must be
+// trivially copyable.
+template <typename K, typename V> struct HashMap {
+    struct Slot {
+        K key;
+        V value;
+    };
+
+    // A default-constructed map has no arena and no table: find, remove and
+    // for_each see it as empty, but it must be assigned from the arena
+    // constructor before the first insert.
+    HashMap() = default;
+    HashMap(Arena* arena, usize initial_capacity = HASH_MAP_GROUP_WIDTH);
+
+    // Find: Returns a pointer to the value stored for `key`, or nullptr.
+    V* find(const K& key);
+
+    // Insert: Stores `value` under `key`, overwriting any previous value.
+    // Returns a pointer to the stored value, valid until the next insert.
+    V* insert(const K& key, const V& value);
+
+    // Remove: Erases `key`. Returns false if it was not present.
+    bool remove(const K& key);
+
+    void clear();
+    usize get_count();
+
+    // ForEach: Calls `f(const K&, V&)` for every entry.
+    template <typename F> void for_each(F&& f);
+
+  private:
+    Arena* arena{};
+    u8* ctrl{};
+    Slot* slots{};
+    usize capacity{}; // Power of two, multiple of HASH_MAP_GROUP_WIDTH
+    usize count{};
+    usize tombstones{};
+
+    void allocate(usize new_capacity);
+    void rehash(usize new_capacity);
+    Slot* find_slot(const K& key, u64 hash);
+    usize find_insert_index(u64 hash);
+};
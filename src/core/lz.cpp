@@ -0,0 +1,455 @@
+#include "core/lz.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+
+// Shortest match a sequence can encode
+#define LZ_MIN_MATCH 4
+// A match starts at least LZ_MF_LIMIT bytes before the end of its block and
+// the last LZ_LAST_LITERALS bytes are always literals, which is what lets
+// the decoder copy in 16-byte steps without running off the end
+#define LZ_MF_LIMIT 12
+#define LZ_LAST_LITERALS 5
+#define LZ_HASH_BITS 13
+// After 2^LZ_SKIP_TRIGGER misses in a row the match search starts stepping
+// over bytes, so incompressible data passes through quickly
+#define LZ_SKIP_TRIGGER 6
+
+static inline u16 lz_read_u16(const u8* p) {
+    u16 value;
+    SDL_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline u32 lz_read_u32(const u8* p) {
+    u32 value;
+    SDL_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline u64 lz_read_u64(const u8* p) {
+    u64 value;
+    SDL_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline u32 lz_hash(u32 sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+/**
+ * @brief Writes the extra bytes of a literal or match length that did not
+ * fit in its 4-bit token field.
+ * @return The position after the written bytes.
+ */
+static inline u8* lz_write_length(u8* op, usize length) {
+    for (length -= 15; length >= 255; length -= 255) {
+        *op++ = 255;
+    }
+    *op++ = (u8)length;
+    return op;
+}
+
+/**
+ * @brief Adds the extra bytes of a length whose token field is 15.
+ * @return False if the bytes run past the end of the block.
+ */
+static inline bool lz_read_length(const u8** ip, const u8* ip_end, usize* length) {
+    u32 byte;
+    do {
+        if (*ip >= ip_end) return false;
+        byte = *(*ip)++;
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * @brief Compresses one block with greedy matching against a hash table of
+ * recent positions.
+ * @param src Block bytes, at most 64 KB so positions fit the table.
+ * @param dst_capacity Output budget; compression gives up beyond it.
+ * @return The compressed size, or 0 if it would exceed `dst_capacity`.
+ */
+static usize lz_compress_block(const u8* src, usize size, u8* dst, usize dst_capacity) {
+    DEBUG_ASSERT(size <= KB(64), "LZ blocks are limited to 64 KB");
+
+    u16 table[1 << LZ_HASH_BITS];
+    SDL_memset(table, 0, sizeof(table));
+
+    const u8* ip = src;
+    const u8* anchor = src;
+    const u8* end = src + size;
+    u8* op = dst;
+    u8* op_end = dst + dst_capacity;
+
+    if (size > LZ_MF_LIMIT) {
+        const u8* search_limit = end - LZ_MF_LIMIT;
+        const u8* match_limit = end - LZ_LAST_LITERALS;
+
+        // Position 0 is in the table already, as every slot starts at it
+        ip++;
+        for (;;) {
+            const u8* ref = nullptr;
+            u32 attempts = 1u << LZ_SKIP_TRIGGER;
+            while (ip <= search_limit) {
+                u32 sequence = lz_read_u32(ip);
+                u32 hash = lz_hash(sequence);
+                const u8* candidate = src + table[hash];
+                table[hash] = (u16)(ip - src);
+                if (lz_read_u32(candidate) == sequence) {
+                    ref = candidate;
+                    break;
+                }
+                ip += attempts++ >> LZ_SKIP_TRIGGER;
+            }
+            if (!ref) break;
+
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+
+            // Extend the match 8 bytes at a time; the first differing byte
+            // is the lowest set byte of the XOR on a little-endian target
+            const u8* match_end = ip + LZ_MIN_MATCH;
+            const u8* ref_end = ref + LZ_MIN_MATCH;
+            while (match_end + 8 <= match_limit) {
+                u64 diff = lz_read_u64(match_end) ^ lz_read_u64(ref_end);
+                if (diff != 0) {
+                    match_end += __builtin_ctzll(diff) >> 3;
+                    goto counted;
+                }
+                match_end += 8;
+                ref_end += 8;
+            }
+            while (match_end < match_limit && *match_end == *ref_end) {
+                match_end++;
+                ref_end++;
+            }
+        counted:
+
+            usize literal_length = (usize)(ip - anchor);
+            usize match_length = (usize)(match_end - ip) - LZ_MIN_MATCH;
+            // Room for this sequence and the token that closes the block
+            usize needed = 1 + literal_length / 255 + 1 + literal_length + 2 + match_length / 255 + 1 + 1;
+            if (needed > (usize)(op_end - op)) return 0;
+
+            u8* token = op++;
+            if (literal_length >= 15) {
+                *token = 15 << 4;
+                op = lz_write_length(op, literal_length);
+            } else {
+                *token = (u8)(literal_length << 4);
+            }
+            SDL_memcpy(op, anchor, literal_length);
+            op += literal_length;
+
+            u16 offset = (u16)(ip - ref);
+            SDL_memcpy(op, &offset, sizeof(offset));
+            op += sizeof(offset);
+
+            if (match_length >= 15) {
+                *token |= 15;
+                op = lz_write_length(op, match_length);
+            } else {
+                *token |= (u8)match_length;
+            }
+
+            ip = anchor = match_end;
+            if (ip > search_limit) break;
+            table[lz_hash(lz_read_u32(ip - 2))] = (u16)(ip - 2 - src);
+        }
+    }
+
+    // The block always ends on a sequence of literals only
+    usize literal_length = (usize)(end - anchor);
+    if (1 + literal_length / 255 + 1 + literal_length > (usize)(op_end - op)) return 0;
+    if (literal_length >= 15) {
+        *op++ = 15 << 4;
+        op = lz_write_length(op, literal_length);
+    } else {
+        *op++ = (u8)(literal_length << 4);
+    }
+    SDL_memcpy(op, anchor, literal_length);
+    op += literal_length;
+    return (usize)(op - dst);
+}
+
+/**
+ * @brief Decodes one block, checking every length and offset against both
+ * buffers so corrupt data fails instead of reading or writing out of bounds.
+ *
+ * Literals and matches are copied 16 or 8 bytes at a time while there is
+ * room past their end; the overshoot is overwritten by the next sequence.
+ *
+ * @return True if the block decoded to exactly `dst_size` bytes.
+ */
+static bool lz_decompress_block(const u8* src, usize src_size, u8* dst, usize dst_size) {
+    const u8* ip = src;
+    const u8* ip_end = src + src_size;
+    u8* op = dst;
+    u8* op_end = dst + dst_size;
+
+    for (;;) {
+        if (ip >= ip_end) return false;
+        u32 token = *ip++;
+
+        // Shortcut for the common short sequence: up to 14 literals and a
+        // match of up to 18 bytes at least 8 back, copied in fixed steps
+        // without the length loops. Room past both ends is checked once.
+        if (token < (15 << 4) && (token & 15) != 15 && ip_end - ip >= 16 + 2 && op_end - op >= 32) {
+            usize literal_length = token >> 4;
+            SDL_memcpy(op, ip, 16);
+            ip += literal_length;
+            op += literal_length;
+
+            usize offset = lz_read_u16(ip);
+            usize match_length = (token & 15) + LZ_MIN_MATCH;
+            if (offset >= 8 && offset <= (usize)(op - dst) && ip + 2 < ip_end) {
+                ip += 2;
+                const u8* ref = op - offset;
+                SDL_memcpy(op, ref, 8);
+                SDL_memcpy(op + 8, ref + 8, 8);
+                SDL_memcpy(op + 16, ref + 16, 2);
+                op += match_length;
+                continue;
+            }
+            // Anything else, including the closing sequence, takes the
+            // checked path from the match on
+            ip -= literal_length;
+            op -= literal_length;
+        }
+
+        usize literal_length = token >> 4;
+        if (literal_length == 15 && !lz_read_length(&ip, ip_end, &literal_length)) {
+            return false;
+        }
+        if (literal_length > (usize)(ip_end - ip) || literal_length > (usize)(op_end - op)) {
+            return false;
+        }
+        if (literal_length <= 16 && ip_end - ip >= 16 && op_end - op >= 16) {
+            SDL_memcpy(op, ip, 16);
+        } else {
+            SDL_memcpy(op, ip, literal_length);
+        }
+        ip += literal_length;
+        op += literal_length;
+
+        // The closing sequence has literals only
+        if (ip == ip_end) {
+            return op == op_end;
+        }
+
+        if (ip_end - ip < 2) return false;
+        usize offset = lz_read_u16(ip);
+        ip += 2;
+        if (offset == 0 || offset > (usize)(op - dst)) return false;
+
+        usize match_length = token & 15;
+        if (match_length == 15 && !lz_read_length(&ip, ip_end, &match_length)) {
+            return false;
+        }
+        match_length += LZ_MIN_MATCH;
+        if (match_length > (usize)(op_end - op)) return false;
+
+        const u8* ref = op - offset;
+        u8* match_end = op + match_length;
+        if (offset >= 16 && op_end - match_end >= 16) {
+            do {
+                SDL_memcpy(op, ref, 16);
+                op += 16;
+                ref += 16;
+            } while (op < match_end);
+        } else if (offset >= 8 && op_end - match_end >= 8) {
+            do {
+                SDL_memcpy(op, ref, 8);
+                op += 8;
+                ref += 8;
+            } while (op < match_end);
+        } else if (offset == 1) {
+            SDL_memset(op, *ref, match_length);
+        } else {
+            // Overlapping: each byte may be one this match just wrote
+            while (op < match_end) {
+                *op++ = *ref++;
+            }
+        }
+        op = match_end;
+    }
+}
+
+usize lz_compress_bound(usize raw_size) {
+    usize block_count = (raw_size + LZ_BLOCK_SIZE_DEFAULT - 1) / LZ_BLOCK_SIZE_DEFAULT;
+    return sizeof(LzHeader) + block_count * sizeof(u32) + raw_size;
+}
+
+/**
+ * @brief Compresses a buffer into a stream of independent 64 KB blocks.
+ * Blocks that do not shrink are stored raw.
+ * @param dst Output of at least lz_compress_bound(src_size) bytes.
+ * @return The stream size, or 0 if `dst` is too small.
+ */
+usize lz_compress(const void* src, usize src_size, void* dst, usize dst_capacity) {
+    if (dst_capacity < lz_compress_bound(src_size)) {
+        return 0;
+    }
+
+    LzHeader header{};
+    header.magic = LZ_MAGIC;
+    header.block_size = LZ_BLOCK_SIZE_DEFAULT;
+    header.raw_size = src_size;
+
+    const u8* ip = (const u8*)src;
+    u8* op = (u8*)dst;
+    SDL_memcpy(op, &header, sizeof(header));
+    op += sizeof(header);
+
+    for (usize pos = 0; pos < src_size;) {
+        usize raw = SDL_min(src_size - pos, (usize)LZ_BLOCK_SIZE_DEFAULT);
+        u8* payload = op + sizeof(u32);
+
+        u32 word;
+        usize packed = lz_compress_block(ip + pos, raw, payload, raw - 1);
+        if (packed != 0) {
+            word = (u32)packed;
+        } else {
+            SDL_memcpy(payload, ip + pos, raw);
+            packed = raw;
+            word = LZ_BLOCK_STORED | (u32)raw;
+        }
+        SDL_memcpy(op, &word, sizeof(word));
+        op = payload + packed;
+        pos += raw;
+    }
+    return (usize)(op - (u8*)dst);
+}
+
+bool lz_get_raw_size(const void* src, usize src_size, u64* raw_size) {
+    LzHeader header;
+    if (src_size < sizeof(header)) return false;
+    SDL_memcpy(&header, src, sizeof(header));
+    if (header.magic != LZ_MAGIC) return false;
+    *raw_size = header.raw_size;
+    return true;
+}
+
+bool lz_decompress(const void* src, usize src_size, void* dst, usize dst_size) {
+    LzDecoder decoder;
+    if (!decoder.begin(src, src_size) || decoder.get_raw_size() != dst_size) {
+        return false;
+    }
+    decoder.decode(dst, dst_size);
+    return decoder.is_done();
+}
+
+/**
+ * @brief Decodes a stream into a buffer pushed from `arena`. The arena is
+ * rewound if decoding fails.
+ * @param out_size Receives the decompressed size.
+ * @return The decompressed bytes, or nullptr on failure.
+ */
+u8* lz_decompress(Arena* arena, const void* src, usize src_size, usize* out_size) {
+    u64 raw_size;
+    if (!lz_get_raw_size(src, src_size, &raw_size)) {
+        return nullptr;
+    }
+
+    ArenaTemp temp = arena->begin_temp();
+    u8* dst = (u8*)arena->push(SDL_max((usize)raw_size, (usize)1), 16);
+    if (!dst || !lz_decompress(src, src_size, dst, (usize)raw_size)) {
+        arena->end_temp(temp);
+        return nullptr;
+    }
+    arena->keep_temp(temp);
+    *out_size = (usize)raw_size;
+    return dst;
+}
+
+/**
+ * @brief Reads the stream header and rewinds the decoder to the first
+ * block.
+ * @return False if `src` is not a stream or its block size is invalid.
+ */
+bool LzDecoder::begin(const void* src, usize src_size) {
+    this->src = (const u8*)src;
+    this->src_size = src_size;
+    src_pos = sizeof(LzHeader);
+    raw_pos = 0;
+    raw_size = 0;
+    block_size = 0;
+    failed = true;
+
+    LzHeader header;
+    if (src_size < sizeof(header)) return false;
+    SDL_memcpy(&header, src, sizeof(header));
+    if (header.magic != LZ_MAGIC || header.block_size == 0 || header.block_size > KB(64)) {
+        return false;
+    }
+
+    raw_size = header.raw_size;
+    block_size = header.block_size;
+    failed = false;
+    return true;
+}
+
+/**
+ * @brief Decodes the next whole blocks that fit in `dst`.
+ *
+ * Stops before a block that would not fit, so the caller can flush the
+ * buffer and call again. A corrupt block sets has_failed().
+ *
+ * @return Bytes written to `dst`.
+ */
+usize LzDecoder::decode(void* dst, usize capacity) {
+    u8* out = (u8*)dst;
+    usize written = 0;
+
+    while (!failed && raw_pos < raw_size) {
+        usize raw = (usize)SDL_min((u64)block_size, raw_size - raw_pos);
+        if (capacity - written < raw) break;
+
+        if (src_size - src_pos < sizeof(u32)) {
+            failed = true;
+            break;
+        }
+        u32 word = lz_read_u32(src + src_pos);
+        src_pos += sizeof(u32);
+
+        usize packed = word & LZ_BLOCK_SIZE;
+        if (packed > src_size - src_pos) {
+            failed = true;
+            break;
+        }
+
+        const u8* payload = src + src_pos;
+        if (word & LZ_BLOCK_STORED) {
+            failed = packed != raw;
+            if (!failed) SDL_memcpy(out + written, payload, raw);
+        } else {
+            failed = !lz_decompress_block(payload, packed, out + written, raw);
+        }
+        if (failed) break;
+
+        src_pos += packed;
+        raw_pos += raw;
+        written += raw;
+    }
+    return written;
+}
+
+bool LzDecoder::is_done() const {
+    return !failed && raw_pos == raw_size;
+}
+
+bool LzDecoder::has_failed() const {
+    return failed;
+}
+
+u64 LzDecoder::get_raw_size() const {
+    return raw_size;
+}
+
+u32 LzDecoder::get_block_size() const {
+    return block_size;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+#include "core/utils.h"
+
+// Byte-oriented LZ77 compression in the LZ4 block format, tuned for
+// decoding speed over ratio. Used for cooked assets, which are compressed
+// once offline and decompressed on every load.
+//
+// Stream layout (little-endian):
+//
+//   LzHeader
+//   blocks, each: u32 word, then its payload
+//     word & LZ_BLOCK_STORED   payload is the raw bytes
+//     word & LZ_BLOCK_SIZE     payload size
+//
+// Every block but the last holds block_size raw bytes. Blocks reference no
+// data outside themselves, so a stream decodes block by block into a buffer
+// of any size, at least one block large.
+
+#define LZ_MAGIC 0x31425A4Cu // "LZB1"
+#define LZ_BLOCK_SIZE_DEFAULT KB(64)
+#define LZ_BLOCK_STORED 0x80000000u
+#define LZ_BLOCK_SIZE 0x7FFFFFFFu
+
+struct LzHeader {
+    u32 magic;
+    u32 block_size; // Raw bytes per block, at most 64 KB
+    u64 raw_size;
+};
+
+static_assert(sizeof(LzHeader) == 16);
+
+// LzCompressBound: Largest stream lz_compress can produce for `raw_size`
+// bytes. Incompressible blocks are stored, so this is barely above it.
+usize lz_compress_bound(usize raw_size);
+
+// LzCompress: Compresses `src` into a stream at `dst`. Returns the stream
+// size, or 0 if `dst_capacity` is below lz_compress_bound.
+usize lz_compress(const void* src, usize src_size, void* dst, usize dst_capacity);
+
+// LzGetRawSize: Reads the decompressed size from a stream's header.
+// Returns false if `src` does not start with one.
+bool lz_get_raw_size(const void* src, usize src_size, u64* raw_size);
+
+// LzDecompress: Decodes a whole stream into exactly `dst_size` bytes.
+// Returns false if the stream is corrupt or holds a different size.
+bool lz_decompress(const void* src, usize src_size, void* dst, usize dst_size);
+
+// LzDecompress: Decodes a whole stream into memory pushed from `arena`.
+// Returns nullptr if the stream is corrupt or the arena is full.
+u8* lz_decompress(Arena* arena, const void* src, usize src_size, usize* out_size);
+
+// Incremental decoder for streaming into fixed-size buffers, such as a
+// mapped GPU transfer buffer that is refilled and flushed in turns. The
+// stream must stay readable until decoding finishes.
+struct LzDecoder {
+    // Begin: Starts decoding `src`. Returns false if it is not a stream.
+    bool begin(const void* src, usize src_size);
+
+    // Decode: Decodes as many whole blocks as fit in `capacity` bytes at
+    // `dst` and returns the bytes written. A capacity of at least
+    // get_block_size() always makes progress. Returns 0 once done or failed.
+    usize decode(void* dst, usize capacity);
+
+    bool is_done() const;
+    bool has_failed() const;
+    u64 get_raw_size() const;
+    u32 get_block_size() const;
+
+  private:
+    const u8* src{};
+    usize src_size{};
+    usize src_pos{};
+    u64 raw_size{};
+    u64 raw_pos{};
+    u32 block_size{};
+    bool failed{};
+};
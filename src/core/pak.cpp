@@ -0,0 +1,349 @@
+#include "core/pak.h"
+#include "core/hash_map.h"
+#include "core/lz.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+
+// Compressed payloads are kept only if they save at least 1 / 2^shift of
+// the file; below that the decode costs more than the smaller read saves
+#define PAK_MIN_SAVING_SHIFT 4
+
+static inline u64 pak_align(u64 value) {
+    return (value + PAK_ALIGNMENT - 1) & ~(u64)(PAK_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Checks that [offset, offset + size) lies inside a file of
+ * `file_size` bytes, without overflowing.
+ */
+static inline bool pak_range_ok(u64 offset, u64 size, u64 file_size) {
+    return offset <= file_size && size <= file_size - offset;
+}
+
+/**
+ * @brief Maps an archive and validates its header, tables and entries.
+ *
+ * Every entry is bounds-checked here once, so find() can trust the tables.
+ *
+ * @param path The path to the archive.
+ * @return True if the archive is usable, false otherwise.
+ */
+bool PakArchive::open(const char* path) {
+    close();
+
+    if (!file.open(path)) {
+        return false;
+    }
+
+    const PakHeader* h = (const PakHeader*)file.data;
+    u64 file_size = file.size;
+    if (file_size < sizeof(PakHeader) || h->magic != PAK_MAGIC) {
+        SDL_Log("'%s' is not a pak archive", path);
+        close();
+        return false;
+    }
+    if (h->version != PAK_VERSION) {
+        SDL_Log("Pak archive '%s' has version %u, expected %u", path, h->version, PAK_VERSION);
+        close();
+        return false;
+    }
+
+    bool valid = h->file_size == file_size && h->slot_count >= h->entry_count &&
+                 h->slot_count != 0 && (h->slot_count & (h->slot_count - 1)) == 0 &&
+                 h->entries_offset % alignof(PakEntry) == 0 &&
+                 h->slots_offset % alignof(u32) == 0 &&
+                 pak_range_ok(h->entries_offset, (u64)h->entry_count * sizeof(PakEntry), file_size) &&
+                 pak_range_ok(h->slots_offset, (u64)h->slot_count * sizeof(u32), file_size) &&
+                 pak_range_ok(h->names_offset, h->names_size, file_size);
+    if (!valid) {
+        SDL_Log("Pak archive '%s' is truncated or corrupt", path);
+        close();
+        return false;
+    }
+
+    const PakEntry* e = (const PakEntry*)(file.data + h->entries_offset);
+    const char* n = (const char*)(file.data + h->names_offset);
+    for (u32 i = 0; i < h->entry_count; i++) {
+        bool compression_ok = e[i].compression == PAK_COMPRESSION_LZ ||
+                              (e[i].compression == PAK_COMPRESSION_NONE && e[i].raw_size == e[i].size);
+        bool entry_ok = compression_ok && pak_range_ok(e[i].offset, e[i].size, file_size) &&
+                        pak_range_ok(e[i].name_offset, (u64)e[i].name_length + 1, h->names_size) &&
+                        n[e[i].name_offset + e[i].name_length] == '\0';
+        if (!entry_ok) {
+            SDL_Log("Pak archive '%s' has a corrupt entry %u", path, i);
+            close();
+            return false;
+        }
+    }
+
+    const u32* s = (const u32*)(file.data + h->slots_offset);
+    for (u32 i = 0; i < h->slot_count; i++) {
+        if (s[i] != PAK_SLOT_EMPTY && s[i] >= h->entry_count) {
+            SDL_Log("Pak archive '%s' has a corrupt index", path);
+            close();
+            return false;
+        }
+    }
+
+    header = h;
+    entries = e;
+    slots = s;
+    names = n;
+    return true;
+}
+
+void PakArchive::close() {
+    file.close();
+    header = nullptr;
+    entries = nullptr;
+    slots = nullptr;
+    names = nullptr;
+}
+
+bool PakArchive::is_open() const {
+    return header != nullptr;
+}
+
+/**
+ * @brief Finds an entry by hashing its name and probing the slot table
+ * linearly from the hash's home slot.
+ * @param name Entry name, relative with '/' separators.
+ * @param out Receives the payload on success.
+ * @return True if the entry exists.
+ */
+bool PakArchive::find(const char* name, PakFile* out) const {
+    if (!header) return false;
+
+    usize length = SDL_strlen(name);
+    u64 hash = hash_bytes(name, length);
+    u32 mask = header->slot_count - 1;
+
+    // The table is never full, so the probe always reaches an empty slot
+    for (u32 slot = (u32)hash & mask;; slot = (slot + 1) & mask) {
+        u32 index = slots[slot];
+        if (index == PAK_SLOT_EMPTY) {
+            return false;
+        }
+
+        const PakEntry& entry = entries[index];
+        if (entry.hash == hash && (usize)entry.name_length == length &&
+            SDL_memcmp(names + entry.name_offset, name, length) == 0) {
+            out->data = file.data + entry.offset;
+            out->size = (usize)entry.size;
+            out->raw_size = (usize)entry.raw_size;
+            out->compression = (PakCompression)entry.compression;
+            return true;
+        }
+    }
+}
+
+u32 PakArchive::get_entry_count() const {
+    return header ? header->entry_count : 0;
+}
+
+const char* PakArchive::get_entry_name(u32 index) const {
+    DEBUG_ASSERT(header && index < header->entry_count, "Pak entry index out of range");
+    return names + entries[index].name_offset;
+}
+
+/**
+ * @brief Writes zero bytes until the stream reaches `offset`.
+ */
+static bool pak_pad_to(SDL_IOStream* io, u64 position, u64 offset) {
+    static const u8 zeros[PAK_ALIGNMENT] = {};
+    while (position < offset) {
+        usize n = (usize)SDL_min(offset - position, (u64)sizeof(zeros));
+        if (SDL_WriteIO(io, zeros, n) != n) return false;
+        position += n;
+    }
+    return true;
+}
+
+/**
+ * @brief Builds an archive from a list of files.
+ *
+ * Entries are sorted by name hash and slotted into a table of at least
+ * twice their count. Every source is compressed up front into one scratch
+ * buffer sized for the largest input. Payloads that shrink enough are copied
+ * out of it and kept; the rest are copied from the mapped source file.
+ *
+ * @param arena Arena for the tables and compressed payloads; rewound before
+ * returning.
+ * @param out_path Path of the archive to create.
+ * @param inputs Names and source files of the entries.
+ * @param input_count Number of inputs.
+ * @return True on success, false if a source is unreadable, two inputs
+ * share a name, a name is too long, or the archive cannot be written.
+ */
+bool pak_write(Arena* arena, const char* out_path, const PakInput* inputs, u32 input_count) {
+    ArenaTemp temp = arena->begin_temp();
+    defer {
+        arena->end_temp(temp);
+    };
+
+    u32 slot_count = 1;
+    while (slot_count < input_count * 2) {
+        slot_count <<= 1;
+    }
+
+    PakEntry* entries = arena->push_array_zero<PakEntry>(SDL_max(input_count, 1u));
+    u32* order = arena->push_array<u32>(SDL_max(input_count, 1u));
+    u32* slots = arena->push_array<u32>(slot_count);
+    // Compressed payloads, or nullptr where the source is stored as is
+    const u8** packed = arena->push_array_zero<const u8*>(SDL_max(input_count, 1u));
+    if (!entries || !order || !slots || !packed) {
+        SDL_Log("Failed to allocate pak tables for %u entries", input_count);
+        return false;
+    }
+
+    // Entries are stored in hash order; `order` maps them back to inputs
+    for (u32 i = 0; i < input_count; i++) {
+        order[i] = i;
+    }
+    std::sort(order, order + input_count, [&](u32 a, u32 b) {
+        u64 hash_a = hash_bytes(inputs[a].name, SDL_strlen(inputs[a].name));
+        u64 hash_b = hash_bytes(inputs[b].name, SDL_strlen(inputs[b].name));
+        if (hash_a != hash_b) return hash_a < hash_b;
+        return SDL_strcmp(inputs[a].name, inputs[b].name) < 0;
+    });
+
+    u64 names_size = 0;
+    for (u32 i = 0; i < input_count; i++) {
+        const char* name = inputs[order[i]].name;
+        usize name_length = SDL_strlen(name);
+        if (name_length > PAK_MAX_NAME_LENGTH) {
+            SDL_Log("Pak entry name too long: '%s'", name);
+            return false;
+        }
+        entries[i].name_length = (u16)name_length;
+        entries[i].hash = hash_bytes(name, entries[i].name_length);
+        entries[i].name_offset = (u32)names_size;
+        names_size += entries[i].name_length + 1;
+
+        if (i > 0 && entries[i].hash == entries[i - 1].hash &&
+            SDL_strcmp(name, inputs[order[i - 1]].name) == 0) {
+            SDL_Log("Duplicate pak entry '%s'", name);
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < slot_count; i++) {
+        slots[i] = PAK_SLOT_EMPTY;
+    }
+    u32 mask = slot_count - 1;
+    for (u32 i = 0; i < input_count; i++) {
+        u32 slot = (u32)entries[i].hash & mask;
+        while (slots[slot] != PAK_SLOT_EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = i;
+    }
+
+    PakHeader header{};
+    header.magic = PAK_MAGIC;
+    header.version = PAK_VERSION;
+    header.entry_count = input_count;
+    header.slot_count = slot_count;
+    header.entries_offset = sizeof(PakHeader);
+    header.slots_offset = header.entries_offset + (u64)input_count * sizeof(PakEntry);
+    header.names_offset = header.slots_offset + (u64)slot_count * sizeof(u32);
+    header.names_size = names_size;
+
+    usize largest_size = 0;
+    for (u32 i = 0; i < input_count; i++) {
+        largest_size = SDL_max(largest_size, file_get_size(inputs[i].path));
+    }
+    usize scratch_capacity = lz_compress_bound(largest_size);
+    u8* scratch = (u8*)arena->push(scratch_capacity, 16);
+    if (!scratch) {
+        SDL_Log("Failed to allocate %zu bytes of pak compression scratch", scratch_capacity);
+        return false;
+    }
+
+    u64 offset = pak_align(header.names_offset + names_size);
+    for (u32 i = 0; i < input_count; i++) {
+        const char* path = inputs[order[i]].path;
+        FileView source;
+        if (!source.open(path)) {
+            SDL_Log("Pak input not found: '%s'", path);
+            return false;
+        }
+        source.advise(FILE_ADVICE_SEQUENTIAL);
+        entries[i].raw_size = source.size;
+        entries[i].size = source.size;
+        entries[i].compression = PAK_COMPRESSION_NONE;
+
+        // Fails, and the entry is stored, if the file grew past the scratch bound
+        usize compressed_size = lz_compress(source.data, source.size, scratch, scratch_capacity);
+        if (compressed_size != 0 &&
+            compressed_size <= source.size - (source.size >> PAK_MIN_SAVING_SHIFT)) {
+            // Kept in the arena until the archive is written
+            u8* compressed = (u8*)arena->push(compressed_size, 16);
+            if (!compressed) {
+                SDL_Log("Failed to allocate %zu bytes for pak entry '%s'", compressed_size, path);
+                return false;
+            }
+            SDL_memcpy(compressed, scratch, compressed_size);
+            packed[i] = compressed;
+            entries[i].size = compressed_size;
+            entries[i].compression = PAK_COMPRESSION_LZ;
+        }
+
+        entries[i].offset = offset;
+        offset = pak_align(offset + entries[i].size);
+    }
+    header.file_size = input_count ? entries[input_count - 1].offset + entries[input_count - 1].size
+                                   : header.names_offset + names_size;
+
+    char tmp_path[1024];
+    SDL_snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", out_path);
+    SDL_IOStream* io = SDL_IOFromFile(tmp_path, "wb");
+    if (!io) {
+        SDL_Log("Failed to create pak archive '%s': %s", tmp_path, SDL_GetError());
+        return false;
+    }
+
+    bool ok = SDL_WriteIO(io, &header, sizeof(header)) == sizeof(header) &&
+              SDL_WriteIO(io, entries, input_count * sizeof(PakEntry)) == input_count * sizeof(PakEntry) &&
+              SDL_WriteIO(io, slots, slot_count * sizeof(u32)) == slot_count * sizeof(u32);
+    for (u32 i = 0; ok && i < input_count; i++) {
+        const char* name = inputs[order[i]].name;
+        usize name_size = (usize)entries[i].name_length + 1;
+        ok = SDL_WriteIO(io, name, name_size) == name_size;
+    }
+
+    u64 position = header.names_offset + names_size;
+    for (u32 i = 0; ok && i < input_count; i++) {
+        ok = pak_pad_to(io, position, entries[i].offset);
+        position = entries[i].offset;
+
+        if (ok && packed[i]) {
+            ok = SDL_WriteIO(io, packed[i], entries[i].size) == entries[i].size;
+        } else if (ok) {
+            FileView source;
+            ok = source.open(inputs[order[i]].path);
+            if (ok) {
+                source.advise(FILE_ADVICE_SEQUENTIAL);
+                // The source changed size since it was measured
+                ok = source.size == entries[i].size &&
+                     SDL_WriteIO(io, source.data, source.size) == source.size;
+            }
+        }
+        position += entries[i].size;
+    }
+
+    if (!SDL_CloseIO(io)) ok = false;
+    if (!ok) {
+        SDL_Log("Failed to write pak archive '%s': %s", tmp_path, SDL_GetError());
+        SDL_RemovePath(tmp_path);
+        return false;
+    }
+
+    if (!SDL_RenamePath(tmp_path, out_path)) {
+        SDL_Log("Failed to move pak archive into place at '%s': %s", out_path, SDL_GetError());
+        SDL_RemovePath(tmp_path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/file.h"
+#include "core/types.h"
+
+// .pak archive layout (little-endian), written by src/tools/pak_builder:
+//
+//   PakHeader
+//   PakEntry entries[entry_count]   sorted by name hash
+//   u32 slots[slot_count]           open-addressed index into entries
+//   char names[names_size]          NUL-terminated entry names
+//   payloads                        each aligned to PAK_ALIGNMENT
+//
+// A payload is either the file as it was, or an lz stream (core/lz.h) when
+// that made it enough smaller. PakFile says which; raw_size is the size
+// after decompression either way.
+// Entry names are paths relative to the packed directory with '/'
+// separators ("fonts/dejavu.ttf"). They are hashed with hash_bytes, so a
+// change to that function needs a PAK_VERSION bump.
+
+#define PAK_MAGIC 0x314B4150u // "PAK1"
+#define PAK_VERSION 2
+#define PAK_ALIGNMENT 64
+#define PAK_SLOT_EMPTY 0xFFFFFFFFu
+#define PAK_MAX_NAME_LENGTH 0xFFFFu
+
+enum PakCompression : u16 {
+    PAK_COMPRESSION_NONE,
+    PAK_COMPRESSION_LZ,
+};
+
+struct PakHeader {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 slot_count; // Power of two, at least twice entry_count
+    u64 entries_offset;
+    u64 slots_offset;
+    u64 names_offset;
+    u64 names_size;
+    u64 file_size; // A truncated archive is rejected on open
+};
+
+struct PakEntry {
+    u64 hash;
+    u64 offset; // Payload position from the start of the archive
+    u64 size;        // Stored bytes
+    u64 raw_size;    // Bytes after decompression
+    u32 name_offset; // Into the names block
+    u16 name_length; // Without the terminator
+    u16 compression; // PakCompression
+};
+
+static_assert(sizeof(PakHeader) == 56);
+static_assert(sizeof(PakEntry) == 40);
+
+struct PakFile {
+    const u8* data;
+    usize size;
+    usize raw_size;
+    PakCompression compression;
+};
+
+// Read-only view of an archive. The whole file is mapped once; lookups hash
+// the name and probe the slot table, so they take constant time on average
+// and touch no disk. Returned data points into the mapping and stays valid
+// until close().
+struct PakArchive {
+    // Open: Maps and validates the archive. Returns false on failure.
+    bool open(const char* path);
+    void close();
+    bool is_open() const;
+
+    // Find: Looks up an entry by name. Returns false if it is not packed.
+    bool find(const char* name, PakFile* out) const;
+
+    u32 get_entry_count() const;
+    // GetEntryName: Name of the i-th entry, for listing the archive
+    const char* get_entry_name(u32 index) const;
+
+  private:
+    FileView file{};
+    const PakHeader* header{};
+    const PakEntry* entries{};
+    const u32* slots{};
+    const char* names{};
+};
+
+struct PakInput {
+    const char* name; // Name stored in the archive
+    const char* path; // File the payload is read from
+};
+
+// PakWrite: Packs `inputs` into an archive at `out_path`, compressing each
+// file that shrinks by at least 1/16. The archive is
+// written next to it and renamed into place, so a running game never maps
+// a half-written file. Temporary memory comes from `arena`.
+bool pak_write(Arena* arena, const char* out_path, const PakInput* inputs, u32 input_count);
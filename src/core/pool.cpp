@@ -0,0 +1,121 @@
+#include "core/pool.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+#include <new>
+
+template <typename T>
+Pool<T>::Pool(Arena* arena, usize min_chunk_capacity)
+    : arena(arena), chunks(nullptr), free_list(nullptr), count(0) {
+    DEBUG_ASSERT(min_chunk_capacity != 0, "Pool chunk capacity cannot be 0.");
+
+    // A free slot stores the free list link, so it must fit a pointer
+    usize slot_align = SDL_max(alignof(T), alignof(void*));
+    slot_size = SDL_max(sizeof(T), sizeof(void*));
+    slot_size = (slot_size + slot_align - 1) & ~(slot_align - 1);
+
+    // Round the chunk up to a power of two so its header can be found by
+    // masking, then fit as many slots as that size allows
+    usize bitmask_size = ((min_chunk_capacity + 63) / 64) * sizeof(u64);
+    usize min_size = sizeof(PoolChunk) + bitmask_size + slot_align +
+                     min_chunk_capacity * slot_size;
+    chunk_size = 1;
+    while (chunk_size < min_size) {
+        chunk_size <<= 1;
+    }
+
+    chunk_capacity = (chunk_size - sizeof(PoolChunk)) / slot_size;
+    for (;;) {
+        bitmask_size = ((chunk_capacity + 63) / 64) * sizeof(u64);
+        slots_offset = sizeof(PoolChunk) + bitmask_size;
+        slots_offset = (slots_offset + slot_align - 1) & ~(slot_align - 1);
+        if (slots_offset + chunk_capacity * slot_size <= chunk_size) break;
+        chunk_capacity--;
+    }
+}
+
+template <typename T> T* Pool<T>::alloc() {
+    void* slot = free_list;
+    if (slot) {
+        free_list = *(void**)slot;
+    } else {
+        if (!chunks || chunks->bump == chunk_capacity) {
+            if (!grow()) {
+                return nullptr;
+            }
+        }
+        slot = chunks->slots + chunks->bump * slot_size;
+        chunks->bump++;
+    }
+
+    PoolChunk* chunk = get_chunk(slot);
+    usize index = ((u8*)slot - chunk->slots) / slot_size;
+    chunk->live[index / 64] |= (u64)1 << (index % 64);
+    count++;
+
+    return new (slot) T();
+}
+
+template <typename T> void Pool<T>::release(T* item) {
+    DEBUG_ASSERT(item != nullptr, "Cannot release a null pool item.");
+
+    PoolChunk* chunk = get_chunk(item);
+    usize index = ((u8*)item - chunk->slots) / slot_size;
+    u64 bit = (u64)1 << (index % 64);
+    DEBUG_ASSERT(
+        (chunk->live[index / 64] & bit) != 0,
+        "Pool item released twice."
+    );
+    chunk->live[index / 64] &= ~bit;
+    count--;
+
+    item->~T();
+    *(void**)item = free_list;
+    free_list = item;
+}
+
+template <typename T> void Pool<T>::clear() {
+    for_each([](T* item) { item->~T(); });
+    chunks = nullptr;
+    free_list = nullptr;
+    count = 0;
+}
+
+template <typename T> template <typename F> void Pool<T>::for_each(F&& f) {
+    for (PoolChunk* chunk = chunks; chunk; chunk = chunk->next) {
+        usize word_count = (chunk->bump + 63) / 64;
+        for (usize word = 0; word < word_count; word++) {
+            u64 bits = chunk->live[word];
+            while (bits) {
+                usize index = word * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                f((T*)(chunk->slots + index * slot_size));
+            }
+        }
+    }
+}
+
+template <typename T> usize Pool<T>::get_count() {
+    return count;
+}
+
+template <typename T> bool Pool<T>::grow() {
+    u8* memory = (u8*)arena->push(chunk_size, chunk_size);
+    if (!memory) {
+        return false;
+    }
+
+    PoolChunk* chunk = (PoolChunk*)memory;
+    chunk->next = chunks;
+    chunk->bump = 0;
+    chunk->live = (u64*)(memory + sizeof(PoolChunk));
+    chunk->slots = memory + slots_offset;
+    SDL_memset(chunk->live, 0, ((chunk_capacity + 63) / 64) * sizeof(u64));
+
+    chunks = chunk;
+    return true;
+}
+
+template <typename T> PoolChunk* Pool<T>::get_chunk(void* slot) {
+    return (PoolChunk*)((usize)slot & ~(chunk_size - 1));
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+
+// Header at the start of every pool chunk. Chunks are allocated with an
+// alignment equal to their (power of two) size, so the chunk owning any slot
+// is found by masking the slot's address.
+struct PoolChunk {
+    PoolChunk* next; // Previously allocated chunk
+    usize bump;      // Slots handed out at least once (never-used tail after)
+    u64* live;       // One bit per slot, set while the slot holds an item
+    u8* slots;       // First slot
+};
+
+// Fixed-size object pool carved out of an arena. Freed slots are threaded
+// into an intrusive free list, so alloc() and release() are O(1). Live items
+// are visited chunk by chunk in address order for cache-friendly iteration.
+// Chunk memory is returned only when the backing arena is cleared.
+template <typename T> struct Pool {
+    Pool(Arena* arena, usize min_chunk_capacity = 64);
+
+    // Alloc: Returns a value-initialized T, or nullptr if the arena is full.
+    T* alloc();
+
+    // Release: Destroys `item` and puts its slot on the free list.
+    void release(T* item);
+
+    // Clear: Destroys every live item and forgets all chunks. Call this
+    // before rewinding the arena the chunks came from.
+    void clear();
+
+    // ForEach: Calls `f(T*)` on every live item.
+    template <typename F> void for_each(F&& f);
+
+    usize get_count();
+
+  private:
+    Arena* arena;
+    PoolChunk* chunks;
+    // Free slots; the first bytes of each hold the next free slot
+    void* free_list;
+    usize count;
+    // Layout shared by every chunk of this pool
+    usize chunk_size;
+    usize chunk_capacity;
+    usize slot_size;
+    usize slots_offset;
+
+    bool grow();
+    PoolChunk* get_chunk(void* slot);
+};
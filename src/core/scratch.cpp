@@ -0,0 +1,64 @@
+#include "core/scratch.h"
+#include "core/assert.h"
+#include "core/utils.h"
+
+#include <SDL3/SDL.h>
+#include <new>
+
+static thread_local Arena* scratch_arenas[SCRATCH_ARENA_COUNT];
+
+Scratch::Scratch(Arena* arena) : arena(arena), temp(arena->begin_temp()) {
+}
+
+Scratch::~Scratch() {
+    arena->end_temp(temp);
+}
+
+/**
+ * @brief Picks a thread-local scratch arena that does not alias any of the
+ * caller's arenas, creating the thread's pool on first use.
+ * @param conflicts Arenas the caller is already allocating from.
+ * @param conflict_count Number of entries in `conflicts`.
+ * @return A scoped scratch handle that rewinds the arena when destroyed.
+ */
+Scratch get_scratch(Arena* const* conflicts, usize conflict_count) {
+    for (usize i = 0; i < SCRATCH_ARENA_COUNT; i++) {
+        if (!scratch_arenas[i]) {
+            void* memory = SDL_malloc(sizeof(Arena));
+            scratch_arenas[i] = new (memory)
+                Arena(SCRATCH_ARENA_RESERVE, true, ARENA_BACKEND_VIRTUAL);
+        }
+
+        bool conflicting = false;
+        for (usize j = 0; j < conflict_count; j++) {
+            if (scratch_arenas[i] == conflicts[j]) {
+                conflicting = true;
+                break;
+            }
+        }
+
+        if (!conflicting) {
+            return Scratch(scratch_arenas[i]);
+        }
+    }
+
+    DEBUG_ASSERT(false, "Every scratch arena conflicts with the caller's.");
+    unreachable;
+}
+
+template <typename... Conflicts>
+    requires(std::is_convertible_v<Conflicts, Arena*> && ...)
+Scratch get_scratch(Conflicts... conflicts) {
+    Arena* conflict_list[] = {nullptr, conflicts...};
+    return get_scratch(conflict_list + 1, sizeof...(conflicts));
+}
+
+void release_scratch_arenas() {
+    for (usize i = 0; i < SCRATCH_ARENA_COUNT; i++) {
+        if (scratch_arenas[i]) {
+            scratch_arenas[i]->destroy();
+            SDL_free(scratch_arenas[i]);
+            scratch_arenas[i] = nullptr;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+
+#include <type_traits>
+
+// Number of scratch arenas each thread owns. Two is enough as long as a
+// function never needs more than one scratch arena besides the one its
+// caller passed in for the result.
+#define SCRATCH_ARENA_COUNT 2
+#define SCRATCH_ARENA_RESERVE ((usize)256 * 1024 * 1024)
+
+// Scoped handle to one of the calling thread's scratch arenas. Everything
+// pushed through `arena` while the handle is alive is released when it goes
+// out of scope.
+struct Scratch {
+    Arena* arena;
+
+    Scratch(Arena* arena);
+    ~Scratch();
+
+    Scratch(const Scratch&) = delete;
+    Scratch& operator=(const Scratch&) = delete;
+
+  private:
+    ArenaTemp temp;
+};
+
+// Returns a scratch arena of the calling thread that is none of `conflicts`.
+// Pass every arena the caller is already allocating from (typically the
+// arena it received for its own results) so the two never alias.
+Scratch get_scratch(Arena* const* conflicts, usize conflict_count);
+
+template <typename... Conflicts>
+    requires(std::is_convertible_v<Conflicts, Arena*> && ...)
+Scratch get_scratch(Conflicts... conflicts);
+
+// Releases the calling thread's scratch arenas. Call before a thread exits.
+void release_scratch_arenas();
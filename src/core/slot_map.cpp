@@ -0,0 +1,108 @@
+#include "core/slot_map.h"
+#include "core/assert.h"
+
+template <typename T>
+SlotMap<T>::SlotMap(Arena* arena, usize initial_capacity)
+    : dense(arena, initial_capacity), dense_slots(arena, initial_capacity),
+      slots(arena, initial_capacity) {}
+
+template <typename T> u32 SlotMap<T>::insert(const T& value) {
+    u32 slot_index;
+    if (free_head != SLOT_MAP_INDEX_MASK) {
+        slot_index = free_head;
+        free_head = slots[slot_index].dense_index;
+    } else {
+        // The all-ones index is the free list terminator
+        DEBUG_ASSERT(
+            slots.size < SLOT_MAP_INDEX_MASK,
+            "SlotMap ran out of handle indices"
+        );
+        slot_index = (u32)slots.push({0, 1});
+    }
+
+    SlotMapSlot& slot = slots[slot_index];
+    slot.dense_index = (u32)dense.push(value);
+    dense_slots.push(slot_index);
+
+    return (slot.generation << SLOT_MAP_INDEX_BITS) | slot_index;
+}
+
+template <typename T> T* SlotMap<T>::get(u32 handle) {
+    SlotMapSlot* slot = find_slot(handle);
+    return slot ? &dense[slot->dense_index] : nullptr;
+}
+
+template <typename T> bool SlotMap<T>::remove(u32 handle) {
+    SlotMapSlot* slot = find_slot(handle);
+    if (!slot) {
+        return false;
+    }
+
+    // Fill the hole with the last value and repoint its slot
+    u32 hole = slot->dense_index;
+    u32 last = (u32)dense.size - 1;
+    if (hole != last) {
+        dense[hole] = dense[last];
+        dense_slots[hole] = dense_slots[last];
+        slots[dense_slots[hole]].dense_index = hole;
+    }
+    dense.pop();
+    dense_slots.pop();
+
+    release_slot(handle & SLOT_MAP_INDEX_MASK);
+    return true;
+}
+
+template <typename T> void SlotMap<T>::clear() {
+    // Slots are kept so their generations keep invalidating old handles
+    for (usize i = 0; i < dense_slots.size; i++) {
+        release_slot(dense_slots[i]);
+    }
+    dense.clear();
+    dense_slots.clear();
+}
+
+template <typename T> bool SlotMap<T>::contains(u32 handle) {
+    return find_slot(handle) != nullptr;
+}
+
+template <typename T> usize SlotMap<T>::get_count() {
+    return dense.size;
+}
+
+template <typename T> std::span<T> SlotMap<T>::values() {
+    return {dense.items, dense.size};
+}
+
+template <typename T>
+template <typename F>
+void SlotMap<T>::for_each(F&& f) {
+    for (usize i = 0; i < dense.size; i++) {
+        u32 slot_index = dense_slots[i];
+        u32 handle =
+            (slots[slot_index].generation << SLOT_MAP_INDEX_BITS) | slot_index;
+        f(handle, dense[i]);
+    }
+}
+
+template <typename T> void SlotMap<T>::release_slot(u32 slot_index) {
+    SlotMapSlot& slot = slots[slot_index];
+    if (slot.generation == SLOT_MAP_MAX_GENERATION) {
+        // Reusing the slot would wrap its generation; retire it instead
+        slot.generation = 0;
+        return;
+    }
+    slot.generation++;
+    slot.dense_index = free_head;
+    free_head = slot_index;
+}
+
+template <typename T> SlotMapSlot* SlotMap<T>::find_slot(u32 handle) {
+    u32 slot_index = handle & SLOT_MAP_INDEX_MASK;
+    u32 generation = handle >> SLOT_MAP_INDEX_BITS;
+    if (generation == 0 || slot_index >= slots.size) {
+        return nullptr;
+    }
+    SlotMapSlot* slot = &slots[slot_index];
+    return slot->generation == generation ? slot : nullptr;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/dyn_array.h"
+#include "core/types.h"
+
+#include <span>
+
+// Handles pack a slot index (low bits) with the slot's generation (high
+// bits). Generations start at 1, so no valid handle is ever 0.
+#define SLOT_HANDLE_NONE 0
+#define SLOT_MAP_INDEX_BITS 20
+#define SLOT_MAP_INDEX_MASK ((1u << SLOT_MAP_INDEX_BITS) - 1)
+#define SLOT_MAP_MAX_GENERATION ((1u << (32 - SLOT_MAP_INDEX_BITS)) - 1)
+
+struct SlotMapSlot {
+    u32 dense_index; // Position in the dense arrays, or next free slot
+    u32 generation;  // Bumped on every removal
+};
+
+// Container of values addressed by 32-bit generational handles. Values are
+// packed densely for iteration; a sparse slot table maps handles to dense
+// positions. Insert, remove and lookup are O(1): removal moves the last
+// value into the hole. A handle goes stale once its value is removed, and
+// a slot whose generation is exhausted is retired instead of reused, so a
+// stale handle can never alias a newer value. Storage comes from an arena;
+// values must be trivially copyable.
+template <typename T> struct SlotMap {
+    SlotMap() = default;
+    SlotMap(Arena* arena, usize initial_capacity = 0);
+
+    // Insert: Stores `value` and returns its handle.
+    u32 insert(const T& value);
+
+    // Get: Returns the value for `handle`, or nullptr if it is stale.
+    // The pointer is valid until the next insert or remove.
+    T* get(u32 handle);
+
+    // Remove: Erases the value for `handle`. Returns false if it is stale.
+    bool remove(u32 handle);
+
+    // Clear: Removes every value and invalidates all outstanding handles.
+    void clear();
+
+    bool contains(u32 handle);
+    usize get_count();
+
+    // Values: Every live value, densely packed in no particular order.
+    std::span<T> values();
+
+    // ForEach: Calls `f(u32 handle, T&)` for every live value.
+    template <typename F> void for_each(F&& f);
+
+  private:
+    DynArray<T> dense{};
+    DynArray<u32> dense_slots{}; // Slot index owning each dense value
+    DynArray<SlotMapSlot> slots{};
+    u32 free_head{SLOT_MAP_INDEX_MASK}; // SLOT_MAP_INDEX_MASK means none
+
+    SlotMapSlot* find_slot(u32 handle);
+    // ReleaseSlot: Invalidates the slot's handles and frees it for reuse
+    void release_slot(u32 slot_index);
+};
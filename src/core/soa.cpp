@@ -0,0 +1,77 @@
+#include "core/soa.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+#include <type_traits>
+
+template <typename... Fields>
+SoA<Fields...>::SoA(Arena* arena, usize capacity) : capacity(capacity) {
+    static_assert(
+        (std::is_trivially_copyable_v<Fields> && ...),
+        "SoA fields are stored in raw arena streams"
+    );
+    DEBUG_ASSERT(arena != nullptr, "SoA requires an arena");
+
+    streams = std::tuple<Fields*...>{(Fields*)arena->push(
+        sizeof(Fields) * capacity,
+        SDL_max(alignof(Fields), (usize)SOA_STREAM_ALIGNMENT)
+    )...};
+}
+
+template <typename... Fields>
+typename SoA<Fields...>::Ref SoA<Fields...>::operator[](usize idx) {
+    DEBUG_ASSERT(idx < size, "SoA access out of bounds");
+    return ref_at(idx, std::index_sequence_for<Fields...>{});
+}
+
+template <typename... Fields>
+usize SoA<Fields...>::push(const Fields&... values) {
+    DEBUG_ASSERT(size < capacity, "SoA full");
+    ref_at(size, std::index_sequence_for<Fields...>{}) =
+        std::tie(values...);
+    return size++;
+}
+
+template <typename... Fields> void SoA<Fields...>::clear() { size = 0; }
+
+template <typename... Fields> bool SoA<Fields...>::is_full() {
+    return size == capacity;
+}
+
+template <typename... Fields> bool SoA<Fields...>::is_empty() {
+    return size == 0;
+}
+
+template <typename... Fields>
+template <usize I>
+std::span<typename SoA<Fields...>::template Field<I>> SoA<Fields...>::span() {
+    return {std::get<I>(streams), size};
+}
+
+template <typename... Fields>
+template <usize I>
+typename SoA<Fields...>::template Field<I>* SoA<Fields...>::data() {
+    return std::get<I>(streams);
+}
+
+template <typename... Fields>
+template <typename Packed>
+void SoA<Fields...>::pack(Packed* dst) {
+    pack_streams(dst, std::index_sequence_for<Fields...>{});
+}
+
+template <typename... Fields>
+template <usize... I>
+typename SoA<Fields...>::Ref
+SoA<Fields...>::ref_at(usize idx, std::index_sequence<I...>) {
+    return Ref{std::get<I>(streams)[idx]...};
+}
+
+template <typename... Fields>
+template <typename Packed, usize... I>
+void SoA<Fields...>::pack_streams(Packed* dst, std::index_sequence<I...>) {
+    // Written strictly front to back, which suits write-combined mappings
+    for (usize i = 0; i < size; i++) {
+        dst[i] = Packed{std::get<I>(streams)[i]...};
+    }
+}
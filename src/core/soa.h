@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/types.h"
+
+#include <span>
+#include <tuple>
+#include <utility>
+
+// Every stream starts on its own cache line so SIMD loads never straddle
+#define SOA_STREAM_ALIGNMENT 64
+
+// Fixed-capacity structure-of-arrays container: each field lives in its own
+// contiguous stream allocated from an arena, so a pass that only reads one
+// field (e.g. positions) only pulls that field through the cache. Elements
+// are accessed through a tuple of references; `span<I>()` exposes a whole
+// stream to bulk/SIMD kernels and `pack` interleaves the streams into an
+// AoS layout (e.g. a mapped GPU transfer buffer) at upload time. Fields
+// must be trivially copyable.
+template <typename... Fields> struct SoA {
+    template <usize I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+    using Ref = std::tuple<Fields&...>;
+
+    std::tuple<Fields*...> streams{};
+    usize size{};
+    usize capacity{};
+
+    SoA() = default;
+    SoA(Arena* arena, usize capacity);
+
+    // Index: Proxy reference to element `idx`, one reference per field.
+    // Unpack with `auto [a, b] = soa[i];`
+    Ref operator[](usize idx);
+    usize push(const Fields&... values);
+    void clear();
+    bool is_full();
+    bool is_empty();
+
+    // Span: The live part of stream `I`
+    template <usize I> std::span<Field<I>> span();
+    template <usize I> Field<I>* data();
+
+    // Pack: Writes element i as `Packed{field0[i], field1[i], ...}` to dst[i]
+    template <typename Packed> void pack(Packed* dst);
+
+  private:
+    template <usize... I> Ref ref_at(usize idx, std::index_sequence<I...>);
+    template <typename Packed, usize... I>
+    void pack_streams(Packed* dst, std::index_sequence<I...>);
+};
@@ -0,0 +1,41 @@
+#include "core/string_interner.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+
+StringInterner::StringInterner(Arena* arena, usize initial_capacity)
+    : arena(arena), ids(arena, initial_capacity),
+      strings(arena, initial_capacity) {
+    strings.push(std::string_view(""));
+}
+
+u32 StringInterner::intern(std::string_view str) {
+    u32* existing = ids.find(str);
+    if (existing) {
+        return *existing;
+    }
+
+    char* copy = arena->push_array<char>(str.size() + 1);
+    DEBUG_ASSERT(copy != nullptr, "Failed to allocate interned string");
+    SDL_memcpy(copy, str.data(), str.size());
+    copy[str.size()] = '\0';
+
+    std::string_view stored(copy, str.size());
+    u32 id = (u32)strings.push(stored);
+    ids.insert(stored, id);
+    return id;
+}
+
+u32 StringInterner::find(std::string_view str) {
+    u32* existing = ids.find(str);
+    return existing ? *existing : INTERN_ID_NONE;
+}
+
+const char* StringInterner::get(u32 id) {
+    DEBUG_ASSERT(id != INTERN_ID_NONE, "INTERN_ID_NONE has no string");
+    return strings[id].data();
+}
+
+usize StringInterner::get_count() {
+    return strings.size - 1;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/dyn_array.h"
+#include "core/hash_map.h"
+#include "core/types.h"
+
+#include <string_view>
+
+// Reserved id that no interned string ever receives
+#define INTERN_ID_NONE 0
+
+// Maps strings to stable 32-bit ids. Every distinct string is copied once
+// into the arena (null-terminated) and keeps its id for the interner's
+// lifetime, so ids can be stored and compared instead of strings.
+struct StringInterner {
+    // Placeholder only; assign from the arena constructor before interning
+    StringInterner() = default;
+    StringInterner(Arena* arena, usize initial_capacity = 64);
+
+    // Intern: Returns the id of `str`, assigning a new one on first sight.
+    u32 intern(std::string_view str);
+
+    // Find: Returns the id of `str`, or INTERN_ID_NONE if never interned.
+    u32 find(std::string_view str);
+
+    // Get: Returns the interned copy of the string with id `id`.
+    const char* get(u32 id);
+
+    usize get_count();
+
+  private:
+    Arena* arena{};
+    HashMap<std::string_view, u32> ids{};
+    // Indexed by id; slot INTERN_ID_NONE holds an empty string
+    DynArray<std::string_view> strings{};
+};
@@ -0,0 +1,192 @@
+#include "core/virtual_memory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Returns the granularity commit/decommit operate on.
+ * @return The OS page size in bytes.
+ */
+usize vm_page_size() {
+    static usize page_size = 0;
+    if (page_size == 0) {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        page_size = (usize)info.dwPageSize;
+#else
+        page_size = (usize)sysconf(_SC_PAGESIZE);
+#endif
+    }
+    return page_size;
+}
+
+/**
+ * @brief Reserves a range of address space without backing it with memory.
+ * @param size Number of bytes to reserve, rounded up to the page size.
+ * @return Base of the reservation, or nullptr on failure.
+ */
+void* vm_reserve(usize size) {
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* ptr = mmap(
+        nullptr,
+        size,
+        PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+        -1,
+        0
+    );
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+#if defined(__linux__)
+/**
+ * @brief Checks whether the kernel hands out transparent huge pages for
+ * ranges marked with MADV_HUGEPAGE. madvise() itself succeeds even when
+ * THP is disabled, so the mode has to be read from sysfs.
+ * @return True if the THP mode is "always" or "madvise".
+ */
+static bool vm_thp_enabled() {
+    static i32 enabled = -1;
+    if (enabled < 0) {
+        enabled = 0;
+        int fd = open("/sys/kernel/mm/transparent_hugepage/enabled", O_RDONLY);
+        if (fd >= 0) {
+            // e.g. "always [madvise] never"; the bracketed word is the mode
+            char mode[128] = {};
+            ssize_t n = read(fd, mode, sizeof(mode) - 1);
+            close(fd);
+            if (n > 0) {
+                enabled = strstr(mode, "[always]") || strstr(mode, "[madvise]");
+            }
+        }
+    }
+    return enabled == 1;
+}
+#endif
+
+/**
+ * @brief Reserves address space backed by 2 MB pages when the OS allows it.
+ *
+ * A 2 MB aligned range is reserved and marked with MADV_HUGEPAGE so the
+ * kernel can back it with transparent huge pages as it is committed.
+ *
+ * Explicit huge pages are only tried when asked for. The kernel takes them
+ * from the hugetlbfs pool for the whole reservation up front, so touching
+ * committed memory can never fault for lack of pages, but a range reserved
+ * for growth that is never used keeps those pages from everyone else.
+ *
+ * @param size Number of bytes to reserve, a multiple of VM_HUGE_PAGE_SIZE.
+ * @param explicit_pages Try the hugetlbfs pool before transparent pages.
+ * @param backing Receives the kind of pages the range ended up with.
+ * @return Base of the reservation, or nullptr on failure.
+ */
+void* vm_reserve_huge(usize size, bool explicit_pages, VmPageBacking* backing) {
+#if defined(__linux__)
+    if (explicit_pages) {
+        void* ptr = mmap(
+            nullptr,
+            size,
+            PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+            -1,
+            0
+        );
+        if (ptr != MAP_FAILED) {
+            *backing = VM_PAGES_EXPLICIT_HUGE;
+            return ptr;
+        }
+    }
+
+    // Over-reserve so the range can be trimmed to a 2 MB boundary
+    usize padded_size = size + VM_HUGE_PAGE_SIZE;
+    u8* base = (u8*)vm_reserve(padded_size);
+    if (!base) {
+        return nullptr;
+    }
+    u8* aligned = (u8*)(((usize)base + VM_HUGE_PAGE_SIZE - 1) &
+                        ~(VM_HUGE_PAGE_SIZE - 1));
+    if (aligned > base) {
+        munmap(base, aligned - base);
+    }
+    usize tail = (base + padded_size) - (aligned + size);
+    if (tail > 0) {
+        munmap(aligned + size, tail);
+    }
+
+    *backing = vm_thp_enabled() && madvise(aligned, size, MADV_HUGEPAGE) == 0
+                   ? VM_PAGES_TRANSPARENT
+                   : VM_PAGES_SMALL;
+    return aligned;
+#else
+    (void)explicit_pages;
+    // Large pages elsewhere need privileges (Windows) or cannot be committed
+    // lazily (macOS superpages), so fall back to regular pages
+    *backing = VM_PAGES_SMALL;
+    return vm_reserve(size);
+#endif
+}
+
+const char* vm_page_backing_name(VmPageBacking backing) {
+    switch (backing) {
+        case VM_PAGES_SMALL:
+            return "small pages";
+        case VM_PAGES_TRANSPARENT:
+            return "transparent huge pages";
+        case VM_PAGES_EXPLICIT_HUGE:
+            return "explicit huge pages";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Makes a reserved range readable and writable.
+ * @param ptr Page-aligned start of the range.
+ * @param size Number of bytes to commit.
+ * @return True on success, false if the OS refused to back the range.
+ */
+bool vm_commit(void* ptr, usize size) {
+#ifdef _WIN32
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+/**
+ * @brief Returns the physical pages of a committed range to the OS while
+ * keeping the address range reserved. Contents are lost.
+ * @param ptr Page-aligned start of the range.
+ * @param size Number of bytes to decommit.
+ */
+void vm_decommit(void* ptr, usize size) {
+#ifdef _WIN32
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+#else
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+#endif
+}
+
+/**
+ * @brief Releases a whole reservation made with vm_reserve.
+ * @param ptr Base returned by vm_reserve.
+ * @param size Size that was passed to vm_reserve.
+ */
+void vm_release(void* ptr, usize size) {
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "core/types.h"
+
+// Thin wrapper over the OS virtual memory API. Address space is reserved
+// without backing (no access), then committed page-by-page as it is needed.
+// All sizes passed to commit/decommit must be multiples of the page size.
+
+// Size of the large pages vm_reserve_huge tries to back memory with
+#define VM_HUGE_PAGE_SIZE ((usize)2 * 1024 * 1024)
+
+enum VmPageBacking {
+    VM_PAGES_SMALL,          // Regular OS pages
+    VM_PAGES_TRANSPARENT,    // 2 MB aligned, kernel asked to use THP
+    VM_PAGES_EXPLICIT_HUGE,  // Mapped from the hugetlbfs pool
+};
+
+usize vm_page_size();
+void* vm_reserve(usize size);
+
+// Reserves `size` bytes (a multiple of VM_HUGE_PAGE_SIZE) preferring 2 MB
+// pages: transparent huge pages, falling back to small pages. With
+// `explicit_pages`, hugetlbfs pages are tried first; those are taken from
+// the pool for the whole range at once, so only ask for them when `size`
+// matches what will really be used. `backing` receives what was actually
+// obtained. Commit and decommit such ranges in VM_HUGE_PAGE_SIZE steps.
+void* vm_reserve_huge(usize size, bool explicit_pages, VmPageBacking* backing);
+const char* vm_page_backing_name(VmPageBacking backing);
+
+bool vm_commit(void* ptr, usize size);
+void vm_decommit(void* ptr, usize size);
+void vm_release(void* ptr, usize size);
@@ -9,7 +9,8 @@
 #define INITIAL_WINDOW_WIDTH (WIDTH * 3)
 #define INITIAL_WINDOW_HEIGHT (HEIGHT * 3)
 
+// Frames the CPU may record ahead of the GPU
+#define FRAMES_IN_FLIGHT 2
+
 #define NANOS_PER_SEC (1000*1000*1000)
 #define NANOS_PER_MS (1000*1000)
-
-#define MAX_SHADER_FILESIZE MB(1)
@@ -5,35 +5,32 @@
 #include "gfx/sprite_atlas.cpp"
 #include "core/arena.cpp"
 #include "core/array.cpp"
+#include "core/fixed_array.cpp"
+#include "core/soa.cpp"
+#include "core/batch2d.cpp"
+#include "core/fastmath.cpp"
+#include "core/pool.cpp"
+#include "core/dyn_array.cpp"
+#include "core/slot_map.cpp"
+#include "core/hash_map.cpp"
+#include "core/string_interner.cpp"
 #include "core/assert.cpp"
 #include "core/file.cpp"
 #include "game/input.cpp"
-#include "core/math3d.cpp"
+#include "core/virtual_memory.cpp"
+#include "core/scratch.cpp"
+#include "core/concurrent_arena.cpp"
+#include "core/lz.cpp"
+#include "core/pak.cpp"
 #include "gfx/renderer.cpp"
 #include <SDL3/SDL.h>
 
 static bool just_pressed(GameInputType type) {
-    KeyMapping mapping = game_state->key_mappings[type];
-
-    for (usize idx = 0; idx < mapping.keys.size; idx++) {
-        if (input->keys[mapping.keys[idx]].just_pressed) {
-            return true;
-        }
-    }
-
-    return false;
+    return input->keys_pressed.intersects(game_state->action_masks[type]);
 }
 
 static bool is_down(GameInputType type) {
-    KeyMapping mapping = game_state->key_mappings[type];
-
-    for (usize idx = 0; idx < mapping.keys.size; idx++) {
-        if (input->keys[mapping.keys[idx]].is_down) {
-            return true;
-        }
-    }
-
-    return false;
+    return input->keys_down.intersects(game_state->action_masks[type]);
 }
 
 EXPORT_FN void game_update(GameState* gs, Input* is, SpriteAtlas* sa, Renderer* rs) {
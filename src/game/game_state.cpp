@@ -16,4 +16,12 @@ void GameState::register_keymaps() {
     key_mappings[MOUSE2].keys.push(KEY_MOUSE_RIGHT);
 
     key_mappings[TOGGLE_FPS_CAP].keys.push(KEY_T);
+
+    for (i32 type = 0; type < GAME_INPUT_COUNT; type++) {
+        KeyMapping* mapping = &key_mappings[type];
+        action_masks[type].clear();
+        for (usize idx = 0; idx < mapping->keys.size; idx++) {
+            action_masks[type].set(mapping->keys[idx]);
+        }
+    }
 }
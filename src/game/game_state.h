@@ -31,6 +31,8 @@ struct GameState {
     bool fps_cap{true};
     ivec2 player_position{};
     KeyMapping key_mappings[GAME_INPUT_COUNT]{};
+    // key_mappings compiled to bitmasks by register_keymaps
+    KeyBits action_masks[GAME_INPUT_COUNT]{};
 
     void register_keymaps();
 };
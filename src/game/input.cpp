@@ -3,12 +3,68 @@
 #include "core/assert.h"
 #include "gfx/renderer.h"
 
-void Input::begin_frame() {
-    for (i32 i = 0; i < KEY_COUNT; i++) {
-        keys[i].just_pressed = false;
-        keys[i].just_released = false;
-        keys[i].half_transition_count = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INPUT_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INPUT_NEON
+#endif
+
+void KeyBits::set(KeyCodeId key) {
+    words[key >> 6] |= 1ull << (key & 63);
+}
+
+void KeyBits::unset(KeyCodeId key) {
+    words[key >> 6] &= ~(1ull << (key & 63));
+}
+
+bool KeyBits::test(KeyCodeId key) const {
+    return (words[key >> 6] >> (key & 63)) & 1;
+}
+
+bool KeyBits::intersects(const KeyBits& mask) const {
+    u64 any = 0;
+    for (u32 i = 0; i < KEY_WORD_COUNT; i++) {
+        any |= words[i] & mask.words[i];
+    }
+    return any != 0;
+}
+
+void KeyBits::clear() {
+#if defined(INPUT_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    for (u32 i = 0; i < KEY_WORD_COUNT; i += 2) {
+        _mm_store_si128((__m128i*)&words[i], zero);
+    }
+#elif defined(INPUT_NEON)
+    uint64x2_t zero = vdupq_n_u64(0);
+    for (u32 i = 0; i < KEY_WORD_COUNT; i += 2) {
+        vst1q_u64(&words[i], zero);
+    }
+#else
+    for (u32 i = 0; i < KEY_WORD_COUNT; i++) {
+        words[i] = 0;
     }
+#endif
+}
+
+// Records a transition of `key` to `is_down`, ignoring repeats
+static void update_key(Input* input, KeyCodeId key, bool is_down) {
+    if (input->keys_down.test(key) == is_down) return;
+
+    if (is_down) {
+        input->keys_down.set(key);
+        input->keys_pressed.set(key);
+    } else {
+        input->keys_down.unset(key);
+        input->keys_released.set(key);
+    }
+}
+
+void Input::begin_frame() {
+    keys_pressed.clear();
+    keys_released.clear();
 
     prev_mouse_pos = mouse_pos;
     prev_mouse_pos_world = mouse_pos_world;
@@ -18,15 +74,11 @@ void Input::process_key_event(SDL_KeyboardEvent* key_event) {
     SDL_Scancode scancode = key_event->scancode;
     if (scancode < 0 || scancode >= (SDL_Scancode)KEY_COUNT) return;
 
-    Key* key = &input->keys[(KeyCodeId)scancode];
-    bool was_down = key->is_down;
-    key->is_down = (key_event->type == SDL_EVENT_KEY_DOWN);
-
-    if (key->is_down != was_down) {
-        key->half_transition_count++;
-        key->just_pressed = key->is_down && !was_down;
-        key->just_released = !key->is_down && was_down;
-    }
+    update_key(
+        input,
+        (KeyCodeId)scancode,
+        key_event->type == SDL_EVENT_KEY_DOWN
+    );
 }
 
 void Input::process_mouse_motion(SDL_MouseMotionEvent* motion_event) {
@@ -46,31 +98,21 @@ void Input::process_mouse_button_event(SDL_MouseButtonEvent* button_event) {
     u8 button = button_event->button;
     if (button > 3) return;
 
-    Key* mouse_button = &input->keys[KEY_MOUSE_LEFT + button - 1];
-    bool was_down = mouse_button->is_down;
-    mouse_button->is_down = (button_event->type == SDL_EVENT_MOUSE_BUTTON_DOWN);
-
-    if (mouse_button->is_down != was_down) {
-        mouse_button->half_transition_count++;
-        mouse_button->just_pressed = mouse_button->is_down && !was_down;
-        mouse_button->just_released = !mouse_button->is_down && was_down;
-    }
+    update_key(
+        input,
+        (KeyCodeId)(KEY_MOUSE_LEFT + button - 1),
+        button_event->type == SDL_EVENT_MOUSE_BUTTON_DOWN
+    );
 }
 
 bool Input::key_pressed_this_frame(KeyCodeId key_id) {
-    Key key = input->keys[key_id];
-    bool result = (key.is_down && key.half_transition_count == 1) ||
-                  key.half_transition_count > 1;
-    return result;
+    return input->keys_pressed.test(key_id);
 }
 
 bool Input::key_released_this_frame(KeyCodeId key_id) {
-    Key key = input->keys[key_id];
-    bool result = (!key.is_down && key.half_transition_count == 1) ||
-                  key.half_transition_count > 1;
-    return result;
+    return input->keys_released.test(key_id);
 }
 
 bool Input::key_is_down(KeyCodeId key_id) {
-    return input->keys[key_id].is_down;
+    return input->keys_down.test(key_id);
 }
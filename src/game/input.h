@@ -124,11 +124,20 @@ enum KeyCodeId {
 };
 // clang-format on
 
-struct Key {
-    bool is_down{};
-    bool just_pressed{};
-    bool just_released{};
-    u8 half_transition_count{};
+#define KEY_WORD_COUNT (KEY_COUNT / 64)
+static_assert(KEY_COUNT % 64 == 0, "KeyBits assumes whole 64-bit words");
+
+// One bit per KeyCodeId. Aligned so the whole set can be cleared and
+// tested with full-width vector stores/loads.
+struct KeyBits {
+    alignas(64) u64 words[KEY_WORD_COUNT]{};
+
+    void set(KeyCodeId key);
+    void unset(KeyCodeId key);
+    bool test(KeyCodeId key) const;
+    // Intersects: True if any bit is set in both this set and `mask`
+    bool intersects(const KeyBits& mask) const;
+    void clear();
 };
 
 struct Input {
@@ -144,7 +153,10 @@ struct Input {
     ivec2 mouse_pos_world{};
     ivec2 rel_mouse_world{};
 
-    Key keys[KEY_COUNT]{};
+    KeyBits keys_down{};
+    // Keys that went down / up at least once since begin_frame
+    KeyBits keys_pressed{};
+    KeyBits keys_released{};
 
     void begin_frame();
     void process_key_event(SDL_KeyboardEvent* key_event);
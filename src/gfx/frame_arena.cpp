@@ -0,0 +1,84 @@
+#include "gfx/frame_arena.h"
+#include "core/assert.h"
+
+#include <SDL3/SDL.h>
+#include <new>
+
+/**
+ * @brief Creates one virtual arena per frame in flight.
+ * @param arena_reserve Address space reserved by each arena.
+ * @param decommit_threshold Committed bytes each arena keeps when reset.
+ * @param backend Virtual backend of the arenas (small or huge pages).
+ * @return true on success, false if an arena could not be created.
+ */
+bool FrameArenaRing::init(
+    usize arena_reserve,
+    usize decommit_threshold,
+    ArenaBackend backend
+) {
+    for (u32 i = 0; i < FRAMES_IN_FLIGHT; i++) {
+        void* memory = SDL_malloc(sizeof(Arena));
+        if (!memory) {
+            SDL_Log("Failed to allocate frame arena %u", i);
+            return false;
+        }
+        arenas[i] =
+            new (memory) Arena(arena_reserve, true, backend);
+        arenas[i]->set_decommit_threshold(decommit_threshold);
+    }
+    frame_index = 0;
+    return true;
+}
+
+/**
+ * @brief Waits for every outstanding frame fence and frees the arenas.
+ * @param device GPU device the fences were acquired from.
+ */
+void FrameArenaRing::cleanup(SDL_GPUDevice* device) {
+    for (u32 i = 0; i < FRAMES_IN_FLIGHT; i++) {
+        if (fences[i]) {
+            SDL_WaitForGPUFences(device, true, &fences[i], 1);
+            SDL_ReleaseGPUFence(device, fences[i]);
+            fences[i] = nullptr;
+        }
+        if (arenas[i]) {
+            arenas[i]->destroy();
+            SDL_free(arenas[i]);
+            arenas[i] = nullptr;
+        }
+    }
+}
+
+Arena* FrameArenaRing::begin_frame(SDL_GPUDevice* device) {
+    u32 slot = frame_index % FRAMES_IN_FLIGHT;
+
+    // Only blocks when the CPU is a full ring ahead of the GPU
+    if (fences[slot]) {
+        SDL_WaitForGPUFences(device, true, &fences[slot], 1);
+        SDL_ReleaseGPUFence(device, fences[slot]);
+        fences[slot] = nullptr;
+    }
+
+    arenas[slot]->clear();
+    return arenas[slot];
+}
+
+void FrameArenaRing::end_frame(SDL_GPUFence* fence) {
+    u32 slot = frame_index % FRAMES_IN_FLIGHT;
+    DEBUG_ASSERT(fences[slot] == nullptr, "Frame ended twice.");
+    fences[slot] = fence;
+    frame_index++;
+}
+
+Arena* FrameArenaRing::current() {
+    return arenas[frame_index % FRAMES_IN_FLIGHT];
+}
+
+void FrameArenaRing::log_stats() {
+    for (u32 i = 0; i < FRAMES_IN_FLIGHT; i++) {
+        if (!arenas[i]) continue;
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "frame_arena[%u]", i);
+        arenas[i]->log_stats(name);
+    }
+}
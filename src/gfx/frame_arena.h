@@ -0,0 +1,32 @@
+#pragma once
+
+#include "SDL3/SDL_gpu.h"
+#include "core/arena.h"
+#include "core/types.h"
+#include "game/consts.h"
+
+// Ring of per-frame arenas, one per frame the GPU may still be consuming.
+// Memory pushed during frame N stays valid until the fence submitted with
+// frame N has signaled, which is checked when the ring wraps back to it.
+struct FrameArenaRing {
+    Arena* arenas[FRAMES_IN_FLIGHT]{};
+    SDL_GPUFence* fences[FRAMES_IN_FLIGHT]{};
+    u32 frame_index{};
+
+    bool init(
+        usize arena_reserve,
+        usize decommit_threshold,
+        ArenaBackend backend = ARENA_BACKEND_VIRTUAL
+    );
+    void cleanup(SDL_GPUDevice* device);
+
+    // Waits for the GPU to finish the frame that last used the next arena,
+    // resets that arena and returns it.
+    Arena* begin_frame(SDL_GPUDevice* device);
+    // Associates the current arena with the fence of the frame's last
+    // submitted command buffer (may be null if nothing was submitted).
+    void end_frame(SDL_GPUFence* fence);
+
+    Arena* current();
+    void log_stats();
+};
@@ -4,7 +4,10 @@
 #include "SDL3/SDL_stdinc.h"
 #include "core/assert.h"
 #include "core/file.h"
+#include "core/lz.h"
+#include "core/scratch.h"
 #include "core/utils.h"
+#include "core/virtual_memory.h"
 #include "game/consts.h"
 #include "game/input.h"
 #include "gfx/sprite_atlas.h"
@@ -30,34 +33,30 @@ void TextGeometryData::queue_text_sequence(
     vec4 color,
     vec2 offset
 ) {
-    DEBUG_ASSERT(
-        vertices.size + sequence->num_vertices <= MAX_TEXT_VERTICES,
-        "Text vertex buffer overflow"
-    );
-    DEBUG_ASSERT(
-        vertices.size + sequence->num_indices <= MAX_TEXT_INDICES,
-        "Text index buffer overflow"
-    );
-
     i32 vertex_offset = vertices.size;
 
+    TextVertex* dst_vertices = vertices.push_uninit(sequence->num_vertices);
     for (i32 i = 0; i < sequence->num_vertices; i++) {
-        TextVertex vertex{};
+        TextVertex* vertex = &dst_vertices[i];
 
-        vertex.pos.x = sequence->xy[i].x + offset.x;
-        vertex.pos.y = sequence->xy[i].y + offset.y;
-        vertex.pos.z = 0.0f;
-        vertex.color = color;
-        vertex.uv = vec2(sequence->uv[i].x, sequence->uv[i].y);
-
-        vertices.push(vertex);
+        vertex->pos.x = sequence->xy[i].x + offset.x;
+        vertex->pos.y = sequence->xy[i].y + offset.y;
+        vertex->pos.z = 0.0f;
+        vertex->color = color;
+        vertex->uv = vec2(sequence->uv[i].x, sequence->uv[i].y);
     }
 
+    i32* dst_indices = indices.push_uninit(sequence->num_indices);
     for (i32 i = 0; i < sequence->num_indices; i++) {
-        indices.push(sequence->indices[i] + vertex_offset);
+        dst_indices[i] = sequence->indices[i] + vertex_offset;
     }
 }
 
+void TextGeometryData::begin(Arena* frame_arena) {
+    vertices = DynArray<TextVertex>(frame_arena);
+    indices = DynArray<i32>(frame_arena);
+}
+
 void TextGeometryData::reset() {
     vertices.clear();
     indices.clear();
@@ -81,7 +80,9 @@ void TextGeometryData::reset() {
  * @note Sets the global renderer pointer on success
  * @note Logs specific error messages for each failure point
  */
-bool Renderer::init() {
+bool Renderer::init(Arena* arena) {
+    sprite_vertices = SoA<vec2, vec2, vec2, vec2>(arena, MAX_SPRITES);
+
     window = SDL_CreateWindow(
         "FPS: ",
         INITIAL_WINDOW_WIDTH,
@@ -129,6 +130,10 @@ bool Renderer::init() {
         SDL_Log("Failed to set GPU swapchain parameters");
     }
 
+    if (!SDL_SetGPUAllowedFramesInFlight(device, FRAMES_IN_FLIGHT)) {
+        SDL_Log("Failed to set GPU frames in flight: %s", SDL_GetError());
+    }
+
     SDL_GPUTransferBufferCreateInfo transfer_info{
         .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
         .size = (u32)(sizeof(SpriteVertex) * sprite_vertices.capacity),
@@ -222,6 +227,31 @@ bool Renderer::init() {
     SDL_ReleaseGPUTransferBuffer(device, vertex_transfer);
     SDL_ReleaseGPUTransferBuffer(device, index_transfer);
 
+    sprite_pipeline = create_sprite_pipeline();
+    if (!sprite_pipeline) {
+        return false;
+    }
+
+    SDL_GPUBufferCreateInfo transform_buffer_info{};
+    transform_buffer_info.usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+    transform_buffer_info.size =
+        sizeof(SpriteVertex) * sprite_vertices.capacity;
+
+    sprite_vertex_buffer = SDL_CreateGPUBuffer(device, &transform_buffer_info);
+
+    if (!sprite_vertex_buffer) {
+        SDL_Log("Failed to create transform buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Builds the sprite pipeline from the quad shaders.
+ * @return The pipeline, or nullptr if a shader is missing or fails to build.
+ */
+SDL_GPUGraphicsPipeline* Renderer::create_sprite_pipeline() {
     SDL_GPUShader* vertex_shader = load_shader(
         "quad.vert",
         device,
@@ -235,7 +265,7 @@ bool Renderer::init() {
     );
     if (!vertex_shader) {
         SDL_Log("Failed to load vertex shader");
-        return false;
+        return nullptr;
     }
 
     SDL_GPUShader* frag_shader = load_shader(
@@ -251,7 +281,8 @@ bool Renderer::init() {
     );
     if (!frag_shader) {
         SDL_Log("Failed to load fragment shader");
-        return false;
+        SDL_ReleaseGPUShader(device, vertex_shader);
+        return nullptr;
     }
 
     SDL_GPUVertexAttribute vertex_attributes[2]{
@@ -335,46 +366,22 @@ bool Renderer::init() {
         .target_info = target_info,
     };
 
-    sprite_pipeline = SDL_CreateGPUGraphicsPipeline(device, &pipeline_info);
-    if (!sprite_pipeline) {
+    SDL_GPUGraphicsPipeline* pipeline =
+        SDL_CreateGPUGraphicsPipeline(device, &pipeline_info);
+    if (!pipeline) {
         SDL_Log("Failed to create graphics pipeline: %s", SDL_GetError());
-        return false;
     }
 
     SDL_ReleaseGPUShader(device, vertex_shader);
     SDL_ReleaseGPUShader(device, frag_shader);
-
-    SDL_GPUBufferCreateInfo transform_buffer_info{};
-    transform_buffer_info.usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
-    transform_buffer_info.size =
-        sizeof(SpriteVertex) * sprite_vertices.capacity;
-
-    sprite_vertex_buffer = SDL_CreateGPUBuffer(device, &transform_buffer_info);
-
-    if (!sprite_vertex_buffer) {
-        SDL_Log("Failed to create transform buffer: %s", SDL_GetError());
-        return false;
-    }
-
-    return true;
+    return pipeline;
 }
 
-bool Renderer::init_text(const char* fontfile_path) {
-    SDL_strlcpy(font_path, fontfile_path, sizeof(font_path));
-
-    for (usize i = 0; i < FONTSIZE_COUNT; i++) {
-        fonts[i] = TTF_OpenFont(font_path, font_sizes[i]);
-        if (!fonts[i]) {
-            SDL_Log(
-                "Failed to load font %s with size %d: %s",
-                font_path,
-                font_sizes[i],
-                SDL_GetError()
-            );
-            return false;
-        }
-    }
-
+/**
+ * @brief Builds the text pipeline from the font shaders.
+ * @return The pipeline, or nullptr if a shader is missing or fails to build.
+ */
+SDL_GPUGraphicsPipeline* Renderer::create_text_pipeline() {
     SDL_GPUShader* vertex_shader = load_shader(
         "font.vert",
         device,
@@ -401,7 +408,9 @@ bool Renderer::init_text(const char* fontfile_path) {
 
     if (!vertex_shader || !frag_shader) {
         SDL_Log("Failed to load font shaders");
-        return false;
+        if (vertex_shader) SDL_ReleaseGPUShader(device, vertex_shader);
+        if (frag_shader) SDL_ReleaseGPUShader(device, frag_shader);
+        return nullptr;
     }
 
     SDL_GPUColorTargetDescription color_target_description{
@@ -469,49 +478,105 @@ bool Renderer::init_text(const char* fontfile_path) {
         SDL_CreateGPUGraphicsPipeline(device, &pipeline_info);
     if (!pipeline) {
         SDL_Log("Fail to create text pipeline");
-        return false;
     }
-    renderer->text_pipeline = pipeline;
 
     SDL_ReleaseGPUShader(device, vertex_shader);
     SDL_ReleaseGPUShader(device, frag_shader);
+    return pipeline;
+}
 
-    SDL_GPUBufferCreateInfo vertex_buffer_info{
-        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
-        .size = sizeof(TextVertex) * MAX_TEXT_VERTICES,
-    };
-    SDL_GPUBuffer* vertex_buffer =
-        SDL_CreateGPUBuffer(device, &vertex_buffer_info);
-    if (!vertex_buffer) {
-        SDL_Log("Fail to create text vertex buffer");
+/**
+ * @brief Opens every font size from the font asset named by font_path.
+ * @return True on success, false if the asset is missing or unreadable.
+ */
+bool Renderer::load_fonts() {
+    if (!open_asset(font_path, &font_asset)) {
         return false;
     }
-    renderer->text_vertex_buffer = vertex_buffer;
 
-    SDL_GPUBufferCreateInfo index_buffer_info{
-        .usage = SDL_GPU_BUFFERUSAGE_INDEX,
-        .size = sizeof(i32) * MAX_TEXT_INDICES,
-    };
-    SDL_GPUBuffer* index_buffer =
-        SDL_CreateGPUBuffer(device, &index_buffer_info);
-    if (!index_buffer) {
-        SDL_Log("Fail to create text_index_buffer");
+    for (usize i = 0; i < FONTSIZE_COUNT; i++) {
+        SDL_IOStream* font_io = SDL_IOFromConstMem(font_asset.data, font_asset.size);
+        fonts[i] = font_io ? TTF_OpenFontIO(font_io, true, font_sizes[i]) : nullptr;
+        if (!fonts[i]) {
+            SDL_Log(
+                "Failed to load font %s with size %d: %s",
+                font_path,
+                font_sizes[i],
+                SDL_GetError()
+            );
+            unload_fonts();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Closes the fonts and releases the font asset. Text is shaped every
+ * frame, so nothing else holds on to them.
+ */
+void Renderer::unload_fonts() {
+    for (int i = 0; i < FONTSIZE_COUNT; ++i) {
+        if (fonts[i]) {
+            TTF_CloseFont(fonts[i]);
+            fonts[i] = nullptr;
+        }
+    }
+    font_asset.close();
+}
+
+/**
+ * @brief Rebuilds both pipelines from the current shader assets. The old
+ * pipelines stay in place unless both new ones build.
+ * @return True if the new shaders are in use.
+ */
+bool Renderer::reload_shaders() {
+    SDL_GPUGraphicsPipeline* next_sprite_pipeline = create_sprite_pipeline();
+    SDL_GPUGraphicsPipeline* next_text_pipeline = create_text_pipeline();
+    if (!next_sprite_pipeline || !next_text_pipeline) {
+        if (next_sprite_pipeline) SDL_ReleaseGPUGraphicsPipeline(device, next_sprite_pipeline);
+        if (next_text_pipeline) SDL_ReleaseGPUGraphicsPipeline(device, next_text_pipeline);
+        SDL_Log("Shader reload failed, keeping the previous shaders");
         return false;
     }
-    renderer->text_index_buffer = index_buffer;
 
-    SDL_GPUTransferBufferCreateInfo transfer_buffer_info{
-        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-        .size = (sizeof(TextVertex) * MAX_TEXT_VERTICES) +
-                (sizeof(i32) * MAX_TEXT_INDICES),
-    };
-    SDL_GPUTransferBuffer* transfer_buffer =
-        SDL_CreateGPUTransferBuffer(device, &transfer_buffer_info);
-    if (!transfer_buffer) {
-        SDL_Log("Fail to create text transfer buffer");
+    // Frames in flight keep their own reference, so the old pipelines can go
+    SDL_ReleaseGPUGraphicsPipeline(device, sprite_pipeline);
+    SDL_ReleaseGPUGraphicsPipeline(device, text_pipeline);
+    sprite_pipeline = next_sprite_pipeline;
+    text_pipeline = next_text_pipeline;
+    SDL_Log("Reloaded shaders");
+    return true;
+}
+
+/**
+ * @brief Reopens the fonts from the current font asset.
+ * @return True on success. On failure no fonts are loaded.
+ */
+bool Renderer::reload_fonts() {
+    unload_fonts();
+    if (!load_fonts()) {
+        return false;
+    }
+    SDL_Log("Reloaded fonts from %s", font_path);
+    return true;
+}
+
+bool Renderer::init_text(const char* fontfile_path) {
+    SDL_strlcpy(font_path, fontfile_path, sizeof(font_path));
+
+    if (!load_fonts()) {
+        return false;
+    }
+
+    text_pipeline = create_text_pipeline();
+    if (!text_pipeline) {
+        return false;
+    }
+
+    if (!reserve_text_buffers(TEXT_VERTICES_INITIAL, TEXT_INDICES_INITIAL)) {
         return false;
     }
-    renderer->text_transfer_buffer = transfer_buffer;
 
     SDL_GPUSamplerCreateInfo sampler_info{
         .min_filter = SDL_GPU_FILTER_LINEAR,
@@ -539,12 +604,7 @@ bool Renderer::init_text(const char* fontfile_path) {
 }
 
 void Renderer::cleanup() {
-    for (int i = 0; i < FONTSIZE_COUNT; ++i) {
-        if (fonts[i]) {
-            TTF_CloseFont(fonts[i]);
-            fonts[i] = nullptr;
-        }
-    }
+    unload_fonts();
 
     if (text_engine) {
         TTF_DestroyGPUTextEngine(text_engine);
@@ -605,6 +665,8 @@ void Renderer::cleanup() {
         SDL_ReleaseGPUTransferBuffer(device, text_transfer_buffer);
         text_transfer_buffer = nullptr;
     }
+    text_vertex_capacity = 0;
+    text_index_capacity = 0;
 
     if (device && window) {
         SDL_ReleaseWindowFromGPUDevice(device, window);
@@ -637,22 +699,18 @@ void Renderer::cleanup() {
  * - Aspect ratio correction based on screen dimensions
  * - Purple clear color (119, 33, 111, 255)
  *
+ * @param frame_arena Arena of the frame being rendered. It is not reset
+ * before the returned fence signals, so it holds the frame's CPU-side
+ * geometry.
+ * @return Fence signaled when the frame's GPU work completes, or nullptr if
+ * nothing was submitted. The caller owns the fence.
+ *
  * @note Requires renderer and input to be initialized
  * @note Performs early exit if no transforms are queued
  * @note Creates temporary depth texture for each frame
  */
-void Renderer::render() {
-    // Calculate the view bounds based on the camera's position and dimensions
-    float view_width = game_camera.dimensions.x / game_camera.zoom;
-    float view_height = game_camera.dimensions.y / game_camera.zoom;
-
-    float min_x = game_camera.position.x - view_width / 2.0f;
-    float max_x = game_camera.position.x + view_width / 2.0f;
-    float min_y = game_camera.position.y - view_height / 2.0f;
-    float max_y = game_camera.position.y + view_height / 2.0f;
-
-    mat4x4 camera_matrix =
-        mat4x4::orthographic_projection(min_x, max_x, min_y, max_y);
+SDL_GPUFence* Renderer::render(Arena* frame_arena) {
+    mat4x4 camera_matrix = game_camera.projection();
 
     mat4x4 text_matrices[2]{
         mat4x4::orthographic_projection(
@@ -667,7 +725,7 @@ void Renderer::render() {
     SDL_GPUCommandBuffer* cmdbuf = SDL_AcquireGPUCommandBuffer(device);
     if (!cmdbuf) {
         SDL_Log("Failed to acquire command buffer %s", SDL_GetError());
-        return;
+        return nullptr;
     }
 
     SDL_GPUTexture* swapchain_texture;
@@ -679,10 +737,20 @@ void Renderer::render() {
             nullptr
         )) {
         SDL_Log("Failed to acquire swapchain texture %s", SDL_GetError());
-        return;
+        SDL_CancelGPUCommandBuffer(cmdbuf);
+        return nullptr;
     }
 
-    process_queued_text();
+    process_queued_text(frame_arena);
+
+    // Without room on the GPU the frame goes out without its text
+    if (text_geometry.vertices.size > 0 &&
+        !reserve_text_buffers(
+            text_geometry.vertices.size,
+            text_geometry.indices.size
+        )) {
+        text_geometry.reset();
+    }
 
     if (!sprite_vertices.is_empty()) {
         upload_sprite_data();
@@ -748,12 +816,14 @@ void Renderer::render() {
     }
 
     SDL_EndGPURenderPass(render_pass);
-    SDL_SubmitGPUCommandBuffer(cmdbuf);
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmdbuf);
 
     // Clear per-frame data
     sprite_vertices.clear();
     queued_texts.clear();
     text_geometry.reset();
+
+    return fence;
 }
 
 void Renderer::upload_sprite_data() {
@@ -767,11 +837,7 @@ void Renderer::upload_sprite_data() {
         return;
     }
 
-    SDL_memcpy(
-        transfer_data,
-        sprite_vertices.items,
-        sizeof(SpriteVertex) * sprite_vertices.size
-    );
+    sprite_vertices.pack((SpriteVertex*)transfer_data);
     SDL_UnmapGPUTransferBuffer(device, sprite_transfer_buffer);
 
     SDL_UploadToGPUBuffer(
@@ -803,7 +869,7 @@ void Renderer::upload_text_data() {
 
     usize vertex_bytes = sizeof(TextVertex) * text_geometry.vertices.size;
     usize index_bytes = sizeof(i32) * text_geometry.indices.size;
-    usize index_buffer_offset = sizeof(TextVertex) * MAX_TEXT_VERTICES;
+    usize index_buffer_offset = sizeof(TextVertex) * text_vertex_capacity;
 
     // Copy vertex data
     u8* dst_vertices = (u8*)transfer_data;
@@ -849,7 +915,84 @@ void Renderer::upload_text_data() {
     SDL_SubmitGPUCommandBuffer(upload_cmd);
 }
 
-void Renderer::process_queued_text() {
+/**
+ * @brief Grows the text vertex, index and transfer buffers to hold at least
+ * `vertex_count` vertices and `index_count` indices. Capacities double, so
+ * a growing workload reallocates rarely. SDL keeps released buffers alive
+ * until the frames still using them are done.
+ * @return false if a buffer could not be created; the old ones are kept.
+ */
+bool Renderer::reserve_text_buffers(usize vertex_count, usize index_count) {
+    if (vertex_count <= text_vertex_capacity &&
+        index_count <= text_index_capacity) {
+        return true;
+    }
+
+    u32 vertex_capacity = SDL_max(text_vertex_capacity, TEXT_VERTICES_INITIAL);
+    while (vertex_capacity < vertex_count) {
+        vertex_capacity *= 2;
+    }
+    u32 index_capacity = SDL_max(text_index_capacity, TEXT_INDICES_INITIAL);
+    while (index_capacity < index_count) {
+        index_capacity *= 2;
+    }
+
+    SDL_GPUBufferCreateInfo vertex_buffer_info{
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
+        .size = (u32)sizeof(TextVertex) * vertex_capacity,
+    };
+    SDL_GPUBuffer* vertex_buffer =
+        SDL_CreateGPUBuffer(device, &vertex_buffer_info);
+    if (!vertex_buffer) {
+        SDL_Log("Fail to create text vertex buffer");
+        return false;
+    }
+
+    SDL_GPUBufferCreateInfo index_buffer_info{
+        .usage = SDL_GPU_BUFFERUSAGE_INDEX,
+        .size = (u32)sizeof(i32) * index_capacity,
+    };
+    SDL_GPUBuffer* index_buffer =
+        SDL_CreateGPUBuffer(device, &index_buffer_info);
+    if (!index_buffer) {
+        SDL_Log("Fail to create text_index_buffer");
+        SDL_ReleaseGPUBuffer(device, vertex_buffer);
+        return false;
+    }
+
+    SDL_GPUTransferBufferCreateInfo transfer_buffer_info{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = vertex_buffer_info.size + index_buffer_info.size,
+    };
+    SDL_GPUTransferBuffer* transfer_buffer =
+        SDL_CreateGPUTransferBuffer(device, &transfer_buffer_info);
+    if (!transfer_buffer) {
+        SDL_Log("Fail to create text transfer buffer");
+        SDL_ReleaseGPUBuffer(device, vertex_buffer);
+        SDL_ReleaseGPUBuffer(device, index_buffer);
+        return false;
+    }
+
+    if (text_vertex_buffer) {
+        SDL_ReleaseGPUBuffer(device, text_vertex_buffer);
+    }
+    if (text_index_buffer) {
+        SDL_ReleaseGPUBuffer(device, text_index_buffer);
+    }
+    if (text_transfer_buffer) {
+        SDL_ReleaseGPUTransferBuffer(device, text_transfer_buffer);
+    }
+    text_vertex_buffer = vertex_buffer;
+    text_index_buffer = index_buffer;
+    text_transfer_buffer = transfer_buffer;
+    text_vertex_capacity = vertex_capacity;
+    text_index_capacity = index_capacity;
+    return true;
+}
+
+void Renderer::process_queued_text(Arena* frame_arena) {
+    text_geometry.begin(frame_arena);
+
     // Process queued text into geometry data
     for (usize i = 0; i < queued_texts.size; i++) {
         QueuedText* queued = &queued_texts[i];
@@ -995,14 +1138,12 @@ void Renderer::draw_sprite(SpriteId sprite_id, vec2 pos) {
 
     SpriteAtlasEntry sprite = sprite_atlas->get_sprite_entry(sprite_id);
 
-    SpriteVertex sprite_vertex{
-        .pos = pos - vec2(sprite.size) / 2.0f,
-        .size = vec2(sprite.size),
-        .uv_min = sprite.uv_min,
-        .uv_max = sprite.uv_max,
-    };
-
-    renderer->sprite_vertices.push(sprite_vertex);
+    renderer->sprite_vertices.push(
+        pos - vec2(sprite.size) / 2.0f,
+        vec2(sprite.size),
+        sprite.uv_min,
+        sprite.uv_max
+    );
 }
 
 /**
@@ -1044,14 +1185,12 @@ void Renderer::draw_sprite(SpriteId sprite_id, vec2 pos, vec2 size) {
 
     SpriteAtlasEntry sprite = sprite_atlas->get_sprite_entry(sprite_id);
 
-    SpriteVertex sprite_vertex{
-        .pos = pos - size / 2.0f,
-        .size = size,
-        .uv_min = sprite.uv_min,
-        .uv_max = sprite.uv_max,
-    };
-
-    renderer->sprite_vertices.push(sprite_vertex);
+    renderer->sprite_vertices.push(
+        pos - size / 2.0f,
+        size,
+        sprite.uv_min,
+        sprite.uv_max
+    );
 }
 
 /**
@@ -1137,6 +1276,89 @@ ivec2 screen_to_world(ivec2 screen_pos) {
     return ivec2(x, y);
 }
 
+AssetView::~AssetView() {
+    close();
+}
+
+void AssetView::close() {
+    file.close();
+    if (decoded) {
+        vm_release(decoded, decoded_reserved);
+    }
+    decoded = nullptr;
+    decoded_reserved = 0;
+    data = nullptr;
+    size = 0;
+}
+
+/**
+ * @brief Decompresses a packed entry into pages reserved for it alone, so
+ * they go back to the OS as soon as the view is closed.
+ * @return True on success, false if the pages cannot be committed or the
+ * entry is corrupt.
+ */
+static bool decompress_asset(const char* name, const PakFile& packed, AssetView* out) {
+    usize page_size = vm_page_size();
+    usize reserved = SDL_max((packed.raw_size + page_size - 1) & ~(page_size - 1), page_size);
+    u8* pages = (u8*)vm_reserve(reserved);
+    if (!pages || !vm_commit(pages, reserved)) {
+        if (pages) vm_release(pages, reserved);
+        SDL_Log("Failed to allocate %zu bytes for asset %s", packed.raw_size, name);
+        return false;
+    }
+    out->decoded = pages;
+    out->decoded_reserved = reserved;
+
+    if (!lz_decompress(packed.data, packed.size, pages, packed.raw_size)) {
+        SDL_Log("Asset %s is corrupt in the archive", name);
+        out->close();
+        return false;
+    }
+    out->data = pages;
+    out->size = packed.raw_size;
+    return true;
+}
+
+/**
+ * @brief Looks up an asset in the packed archive, falling back to the loose
+ * file under assets/.
+ *
+ * The fallback keeps runs from the source tree working without a build of
+ * the archive. Entries stored as is are returned in place; compressed ones
+ * are decompressed into memory the view owns.
+ *
+ * @param name Asset path relative to assets/, with '/' separators.
+ * @param out Receives the asset bytes; anything it held is closed first.
+ * @return True if the asset was found, false otherwise.
+ */
+bool open_asset(const char* name, AssetView* out) {
+    out->close();
+
+    PakFile packed;
+    if (asset_pak && asset_pak->find(name, &packed)) {
+        if (packed.compression == PAK_COMPRESSION_LZ) {
+            return decompress_asset(name, packed, out);
+        }
+        out->data = packed.data;
+        out->size = packed.size;
+        return true;
+    }
+
+    char path[1024];
+    i32 length = SDL_snprintf(path, sizeof(path), "assets/%s", name);
+    if (length < 0 || length >= (i32)sizeof(path)) {
+        SDL_Log("Asset path too long: %s", name);
+        return false;
+    }
+    if (!out->file.open(path)) {
+        SDL_Log("Asset not found: %s", name);
+        return false;
+    }
+    out->data = out->file.data;
+    out->size = out->file.size;
+    return true;
+}
+
 /**
  * @brief Loads an image file from the assets directory and converts it to the
  * specified format.
@@ -1151,7 +1373,7 @@ ivec2 screen_to_world(ivec2 screen_pos) {
  * @return SDL_Surface* Loaded and converted image surface, or nullptr on
  * failure
  *
- * @note Automatically constructs full path by prepending "assets/images/"
+ * @note Looks up "images/<image_filename>" through open_asset()
  * @note Converts to ABGR8888 format for GPU compatibility
  * @note Returns nullptr and logs error if loading or conversion fails
  * @note Caller is responsible for freeing the returned surface with
@@ -1159,17 +1381,41 @@ ivec2 screen_to_world(ivec2 screen_pos) {
  */
 SDL_Surface* load_image(const char* image_filename, i32 desired_channels) {
     char full_path[256];
-    SDL_Surface* result;
-    SDL_PixelFormat format;
-
     SDL_snprintf(
         full_path,
         sizeof(full_path),
-        "assets/images/%s",
+        "images/%s",
         image_filename
     );
 
-    result = IMG_Load(full_path);
+    // Decoded straight from the mapping, without reading it into memory
+    AssetView asset;
+    if (!open_asset(full_path, &asset)) {
+        return nullptr;
+    }
+    return load_image_from_memory(asset.data, asset.size, desired_channels);
+}
+
+/**
+ * @brief Decodes an image held in memory and converts it to the specified
+ * format.
+ *
+ * @param data Encoded image bytes (PNG, ...); only read during the call.
+ * @param size Number of bytes at `data`.
+ * @param desired_channels Number of color channels (only 4/RGBA currently
+ * supported)
+ * @return SDL_Surface* Decoded and converted image surface, or nullptr on
+ * failure
+ *
+ * @note Caller is responsible for freeing the returned surface with
+ * SDL_DestroySurface
+ */
+SDL_Surface* load_image_from_memory(const void* data, usize size, i32 desired_channels) {
+    SDL_Surface* result;
+    SDL_PixelFormat format;
+
+    SDL_IOStream* io = SDL_IOFromConstMem(data, size);
+    result = io ? IMG_Load_IO(io, true) : nullptr;
     if (!result) {
         SDL_Log("Failed to load image: %s", SDL_GetError());
         return nullptr;
@@ -1290,10 +1536,10 @@ SDL_GPUTexture* gpu_texture_from_surface(SDL_Surface* surface) {
  * (DirectX 12), and MSL (Metal) formats with automatic format selection and
  * platform-specific entry point handling.
  *
- * Expected shader file locations:
- * - SPIRV: assets/shaders/compiled/[shader_name].spv
- * - DXIL: assets/shaders/compiled/[shader_name].dxil
- * - MSL: assets/shaders/compiled/[shader_name].msl
+ * Expected shader assets, looked up through open_asset():
+ * - SPIRV: shaders/compiled/[shader_name].spv
+ * - DXIL: shaders/compiled/[shader_name].dxil
+ * - MSL: shaders/compiled/[shader_name].msl
  *
  * @param shader_name Base name of the shader file (without extension)
  * @param shader_stage Vertex or fragment shader stage
@@ -1315,11 +1561,6 @@ SDL_GPUShader* load_shader(
     SDL_GPUShaderStage shader_stage,
     ShaderProps shader_props
 ) {
-    Arena arena(MAX_SHADER_FILESIZE, false);
-    defer {
-        arena.destroy();
-    };
-
     SDL_GPUShaderFormat backend_formats = SDL_GetGPUShaderFormats(device);
     SDL_GPUShaderFormat format = SDL_GPU_SHADERFORMAT_INVALID;
     char extension[8] = "";
@@ -1344,7 +1585,7 @@ SDL_GPUShader* load_shader(
     i32 result = SDL_snprintf(
         shader_path,
         sizeof(shader_path),
-        "assets/shaders/compiled/%s%s",
+        "shaders/compiled/%s%s",
         shader_name,
         extension
     );
@@ -1360,14 +1601,18 @@ SDL_GPUShader* load_shader(
         shader_path
     );
 
-    usize code_size = file_get_size(shader_path);
-    char* code = read_entire_file(&arena, shader_path);
+    // SDL copies the bytecode during creation, so the asset can go when this
+    // returns
+    AssetView code;
+    if (!open_asset(shader_path, &code)) {
+        return nullptr;
+    }
 
     return SDL_CreateGPUShader(
         device,
         &(SDL_GPUShaderCreateInfo){
-            .code_size = code_size,
-            .code = (u8*)code,
+            .code_size = code.size,
+            .code = code.data,
             .entrypoint = entrypoint,
             .format = format,
             .stage = shader_stage,
@@ -4,16 +4,22 @@
 #include "SDL3/SDL_video.h"
 #include "SDL3_ttf/SDL_ttf.h"
 #include "core/arena.h"
-#include "core/array.h"
+#include "core/dyn_array.h"
+#include "core/file.h"
+#include "core/fixed_array.h"
 #include "core/math3d.h"
+#include "core/pak.h"
+#include "core/soa.h"
 #include "core/types.h"
 #include "game/consts.h"
 #include "gfx/sprite.h"
 
-// TODO: Need to find a better ideal number for these
+// Sprites per frame. Sprite storage and its GPU buffer are sized for it
+// once at init, and draw_sprite asserts past it.
 #define MAX_SPRITES 5000
-#define MAX_TEXT_VERTICES 5000
-#define MAX_TEXT_INDICES 5000
+// Starting size of the text GPU buffers, which grow to fit a frame's text
+#define TEXT_VERTICES_INITIAL 4096
+#define TEXT_INDICES_INITIAL 6144
 
 enum FontSize {
     FONTSIZE_EXTRASMALL,
@@ -29,8 +35,28 @@ struct Camera2d {
     f32 zoom{1.0};
     vec2 dimensions{WIDTH, HEIGHT};
     vec2 position{160, -90};
+
+    // World-space rectangle the camera sees, e.g. for culling
+    constexpr rect2 view_rect() const {
+        return rect2::from_center(position, dimensions / zoom);
+    }
+
+    // Orthographic projection of the view rectangle centered on position
+    constexpr mat4x4 projection() const {
+        rect2 view = view_rect();
+        return mat4x4::orthographic_projection(
+            view.min.x,
+            view.max.x,
+            view.min.y,
+            view.max.y
+        );
+    }
 };
 
+// The default camera's projection folds to a constant
+static_assert(Camera2d{}.projection()(0, 0) == 2.0f / WIDTH);
+static_assert(Camera2d{}.projection()(3, 1) == 1.0f);
+
 struct SpriteVertex {
     vec2 pos{};
     vec2 size{};
@@ -38,6 +64,14 @@ struct SpriteVertex {
     vec2 uv_max{}; // Normalized UV coordinates from sprite atlas
 };
 
+// Streams of Renderer::sprite_vertices, in SpriteVertex field order
+enum SpriteStream {
+    SPRITE_STREAM_POS,
+    SPRITE_STREAM_SIZE,
+    SPRITE_STREAM_UV_MIN,
+    SPRITE_STREAM_UV_MAX,
+};
+
 struct TextVertex {
     vec3 pos{};
     vec4 color{};
@@ -51,11 +85,14 @@ struct QueuedText {
     FontSize font_size;
 };
 
-// Text geometry data for batching text rendering
+// Text geometry data for batching text rendering. Rebuilt every frame in
+// that frame's arena, so it needs no storage of its own.
 struct TextGeometryData {
-    Array<TextVertex, MAX_TEXT_VERTICES> vertices{};
-    Array<i32, MAX_TEXT_INDICES> indices{};
+    DynArray<TextVertex> vertices{};
+    DynArray<i32> indices{};
 
+    // Begin: Starts a frame's geometry in `frame_arena`
+    void begin(Arena* frame_arena);
     void reset();
     void queue_text_sequence(
         TTF_GPUAtlasDrawSequence* sequence,
@@ -64,6 +101,27 @@ struct TextGeometryData {
     );
 };
 
+// Bytes of one asset, either inside the mapped asset_pak or, when the
+// archive is missing or lacks the entry, in a mapping of the loose file
+// under assets/. Entries the archive stores compressed are decompressed
+// into pages the view owns. Valid until close(), and for entries stored
+// as is, until the archive is closed.
+struct AssetView {
+    const u8* data{};
+    usize size{};
+    FileView file{};
+    u8* decoded{};           // Pages holding a decompressed entry
+    usize decoded_reserved{};
+
+    AssetView() {}
+    ~AssetView();
+    AssetView(const AssetView&) = delete;
+    AssetView& operator=(const AssetView&) = delete;
+
+    // Close: Unmaps the loose file or releases the decompressed pages
+    void close();
+};
+
 struct Renderer {
     SDL_Window* window{};
     SDL_GPUDevice* device{};
@@ -80,10 +138,15 @@ struct Renderer {
     SDL_GPUBuffer* text_vertex_buffer{};
     SDL_GPUBuffer* text_index_buffer{};
     SDL_GPUTransferBuffer* text_transfer_buffer{};
+    u32 text_vertex_capacity{};
+    u32 text_index_capacity{};
     SDL_GPUSampler* text_sampler{};
     TTF_TextEngine* text_engine{};
     SDL_GPUTexture* text_atlas_texture{};
-    char font_path[MB(1)]{};
+    char font_path[MB(1)]; // Left untouched until init_text copies into it
+    // Every size of the font reads from this one asset, so it stays open
+    // until cleanup
+    AssetView font_asset{};
     TTF_Font* fonts[FONTSIZE_COUNT]{};
     int font_sizes[FONTSIZE_COUNT]{12, 16, 24, 32, 36};
 
@@ -92,15 +155,25 @@ struct Renderer {
     Camera2d ui_camera{};
     SDL_GPUTexture* depth_texture{};
     ivec2 depth_texture_size{};
-    Array<SpriteVertex, MAX_SPRITES> sprite_vertices{};
+    // Stored per field; interleaved into SpriteVertex only on upload
+    SoA<vec2, vec2, vec2, vec2> sprite_vertices{};
     TextGeometryData text_geometry{};
-    Array<QueuedText, 100> queued_texts{};
+    FixedArray<QueuedText, 100> queued_texts{};
 
-    bool init();
+    bool init(Arena* arena);
     bool init_text(const char* fontfile_path);
     void cleanup();
 
-    void render();
+    // Hot reload: rebuild from the current assets, keeping what is there
+    // when the new version fails to load
+    bool reload_shaders();
+    bool reload_fonts();
+    // The fonts read straight from their asset, so they are unloaded while
+    // the asset archive they live in is swapped
+    bool load_fonts();
+    void unload_fonts();
+
+    SDL_GPUFence* render(Arena* frame_arena);
     void draw_sprite(SpriteId sprite_id, vec2 pos);
     void draw_sprite(SpriteId sprite_id, ivec2 pos);
     void draw_sprite(SpriteId sprite_id, vec2 pos, vec2 size);
@@ -108,7 +181,10 @@ struct Renderer {
     void draw_text(const char* text, vec2 position, vec4 color, FontSize font_size);
 
   private:
-    void process_queued_text();
+    SDL_GPUGraphicsPipeline* create_sprite_pipeline();
+    SDL_GPUGraphicsPipeline* create_text_pipeline();
+    void process_queued_text(Arena* frame_arena);
+    bool reserve_text_buffers(usize vertex_count, usize index_count);
     void upload_sprite_data();
     void upload_text_data();
     void render_sprite_vertices(
@@ -125,10 +201,17 @@ struct Renderer {
 };
 
 static Renderer* renderer{};
+static PakArchive* asset_pak{};
+
+// OpenAsset: Finds `name` ("images/TEXTURE_ATLAS.png") in asset_pak, or
+// falls back to the loose file. Returns false if neither exists.
+bool open_asset(const char* name, AssetView* out);
 
 ivec2 screen_to_world(ivec2 screen_pos);
 
 SDL_Surface* load_image(const char* image_filename, i32 desired_channels = 4);
+// LoadImageFromMemory: Like load_image, for encoded image bytes already read
+SDL_Surface* load_image_from_memory(const void* data, usize size, i32 desired_channels = 4);
 
 struct ShaderProps {
     u32 num_samplers{};
@@ -3,6 +3,8 @@
 #include "core/math3d.h"
 
 enum SpriteId {
+    SPRITE_INVALID = -1,
+
     SPRITE_WHITE,
     SPRITE_DICE,
 
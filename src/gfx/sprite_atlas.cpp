@@ -5,13 +5,15 @@
 #include "core/utils.h"
 #include <SDL3_image/SDL_image.h>
 
-bool SpriteAtlas::init(const char* atlas_filename) {
+bool SpriteAtlas::init(Arena* arena, const char* atlas_filename) {
     auto device = renderer->device;
     DEBUG_ASSERT(
         device != nullptr,
         "GPU device is null on init_sprite_atlas()"
     );
 
+    sprite_names = HashMap<std::string_view, SpriteId>(arena, 256);
+
     SDL_Surface* atlas_surface = load_image(atlas_filename, 4);
     if (!atlas_surface) {
         SDL_Log("Failed to load sprite atlas: %s", atlas_filename);
@@ -55,6 +57,57 @@ bool SpriteAtlas::init(const char* atlas_filename) {
     return true;
 }
 
+bool SpriteAtlas::reload_texture(const char* atlas_filename) {
+    SDL_Surface* atlas_surface = load_image(atlas_filename, 4);
+    if (!atlas_surface) {
+        SDL_Log("Failed to reload sprite atlas: %s", atlas_filename);
+        return false;
+    }
+    defer {
+        SDL_DestroySurface(atlas_surface);
+    };
+    return replace_texture(atlas_surface);
+}
+
+bool SpriteAtlas::reload_texture_from_memory(const void* data, usize size) {
+    SDL_Surface* atlas_surface = load_image_from_memory(data, size, 4);
+    if (!atlas_surface) {
+        SDL_Log("Failed to decode reloaded sprite atlas");
+        return false;
+    }
+    defer {
+        SDL_DestroySurface(atlas_surface);
+    };
+    return replace_texture(atlas_surface);
+}
+
+bool SpriteAtlas::replace_texture(SDL_Surface* atlas_surface) {
+    auto device = renderer->device;
+
+    SDL_GPUTexture* next_texture = gpu_texture_from_surface(atlas_surface);
+    if (!next_texture) {
+        SDL_Log("Failed to create GPU texture from atlas surface");
+        return false;
+    }
+
+    // Frames in flight keep their own reference to the old texture
+    SDL_ReleaseGPUTexture(device, texture);
+    texture = next_texture;
+
+    ivec2 next_size = ivec2(atlas_surface->w, atlas_surface->h);
+    if (next_size != atlas_size) {
+        atlas_size = next_size;
+        for (usize i = 0; i < sprites.size; i++) {
+            SpriteAtlasEntry& entry = sprites[i];
+            entry.uv_min = vec2(entry.atlas_offset) / vec2(atlas_size);
+            entry.uv_max = vec2(entry.atlas_offset + entry.size) / vec2(atlas_size);
+        }
+    }
+
+    SDL_Log("Reloaded sprite atlas: %dx%d", atlas_size.x, atlas_size.y);
+    return true;
+}
+
 void SpriteAtlas::register_sprites() {
     register_sprite_at_id(
         SPRITE_WHITE,
@@ -85,6 +138,7 @@ void SpriteAtlas::cleanup() {
     }
 
     sprites.clear();
+    sprite_names.clear();
 }
 
 SpriteId SpriteAtlas::register_sprite(
@@ -116,8 +170,11 @@ SpriteId SpriteAtlas::register_sprite(
     entry.uv_min = vec2(atlas_offset) / vec2(atlas_size);
     entry.uv_max = vec2(atlas_offset + size) / vec2(atlas_size);
 
-    sprites.push(entry);
-    return (SpriteId)(sprites.size - 1);
+    SpriteId id = (SpriteId)sprites.push(entry);
+    if (name) {
+        sprite_names.insert(name, id);
+    }
+    return id;
 }
 
 void SpriteAtlas::register_sprite_at_id(
@@ -146,10 +203,13 @@ void SpriteAtlas::register_sprite_at_id(
     );
     DEBUG_ASSERT(size.x > 0 && size.y > 0, "Invalid sprite size");
 
-    SpriteAtlasEntry& entry = sprites.items[id];
+    SpriteAtlasEntry& entry = sprites[id];
     entry.atlas_offset = atlas_offset;
     entry.size = size;
     entry.name = name;
+    if (name) {
+        sprite_names.insert(name, id);
+    }
 
     // Compute normalized UV coordinates
     entry.uv_min = vec2(atlas_offset) / vec2(atlas_size);
@@ -163,14 +223,19 @@ void SpriteAtlas::compute_uv_coords(
 ) const {
     DEBUG_ASSERT(is_valid_sprite_id(sprite_id), "Invalid sprite ID");
 
-    const SpriteAtlasEntry& entry = sprites.items[sprite_id];
+    const SpriteAtlasEntry& entry = sprites.data()[sprite_id];
     *uv_min = entry.uv_min;
     *uv_max = entry.uv_max;
 }
 
 SpriteAtlasEntry SpriteAtlas::get_sprite_entry(SpriteId sprite_id) const {
     DEBUG_ASSERT(is_valid_sprite_id(sprite_id), "Invalid sprite ID");
-    return sprites.items[sprite_id];
+    return sprites.data()[sprite_id];
+}
+
+SpriteId SpriteAtlas::find_sprite(const char* name) {
+    SpriteId* id = sprite_names.find(name);
+    return id ? *id : SPRITE_INVALID;
 }
 
 bool SpriteAtlas::is_valid_sprite_id(SpriteId sprite_id) const {
@@ -2,7 +2,8 @@
 
 #include "SDL3/SDL_gpu.h"
 #include "core/arena.h"
-#include "core/array.h"
+#include "core/fixed_array.h"
+#include "core/hash_map.h"
 #include "gfx/sprite.h"
 #include "core/math3d.h"
 
@@ -11,18 +12,29 @@ struct SpriteAtlasEntry {
     ivec2 size;         // Sprite size in pixels
     vec2 uv_min;        // Normalized UV coordinates (0-1)
     vec2 uv_max;        // Normalized UV coordinates (0-1)
-    const char* name;   // Optional sprite name for debugging
+    const char* name;   // Optional sprite name, resolvable via find_sprite
 };
 
 struct SpriteAtlas {
     SDL_GPUTexture* texture{};
     SDL_GPUSampler* sampler{};
     ivec2 atlas_size{}; // Total atlas dimensions in pixels
-    Array<SpriteAtlasEntry, 256> sprites{};
+    FixedArray<SpriteAtlasEntry, 256> sprites{};
+    HashMap<std::string_view, SpriteId> sprite_names{};
 
-    bool init(const char* atlas_filename);
+    bool init(Arena* arena, const char* atlas_filename);
     void cleanup();
 
+    // ReloadTexture: Replaces the texture with a fresh load of the atlas
+    // image, keeping the old one if that fails. Sprite UVs follow a change
+    // in atlas size.
+    bool reload_texture(const char* atlas_filename);
+    // ReloadTextureFromMemory: Like reload_texture, decoding an atlas image
+    // that was already read, e.g. through AsyncIo.
+    bool reload_texture_from_memory(const void* data, usize size);
+    // ReplaceTexture: Uploads `atlas_surface` as the new texture.
+    bool replace_texture(SDL_Surface* atlas_surface);
+
     void register_sprites();
 
     SpriteId register_sprite(
@@ -46,6 +58,9 @@ struct SpriteAtlas {
 
     SpriteAtlasEntry get_sprite_entry(SpriteId sprite_id) const;
 
+    // Returns the id registered under `name`, or SPRITE_INVALID.
+    SpriteId find_sprite(const char* name);
+
     bool is_valid_sprite_id(SpriteId sprite_id) const;
 };
 
@@ -4,13 +4,29 @@
 #include "core/utils.h"
 #include "core/arena.cpp"
 #include "core/array.cpp"
+#include "core/fixed_array.cpp"
+#include "core/soa.cpp"
+#include "core/batch2d.cpp"
+#include "core/fastmath.cpp"
+#include "core/pool.cpp"
+#include "core/dyn_array.cpp"
+#include "core/slot_map.cpp"
+#include "core/hash_map.cpp"
+#include "core/string_interner.cpp"
 #include "core/assert.cpp"
 #include "core/file.cpp"
-#include "core/math3d.cpp"
+#include "core/virtual_memory.cpp"
+#include "core/scratch.cpp"
+#include "core/concurrent_arena.cpp"
+#include "core/async_io.cpp"
+#include "core/lz.cpp"
+#include "core/pak.cpp"
+#include "core/file_watch.cpp"
 #include "game/input.cpp"
 #include "game/game_state.cpp"
 #include "gfx/renderer.cpp"
 #include "gfx/sprite_atlas.cpp"
+#include "gfx/frame_arena.cpp"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 #include <SDL3_ttf/SDL_ttf.h>
@@ -24,40 +40,373 @@ static f32 last_title_update_time = 0.0f;
 typedef void GameUpdateFn(GameState*, Input*, SpriteAtlas*, Renderer*);
 static GameUpdateFn* game_update_ptr;
 
-static void reload_game_dll(Arena* transient_storage) {
-    static SDL_SharedObject* game_dll;
-    static u64 game_dll_timestamp;
+static AsyncIo* async_io{};
+static FileWatcher* file_watcher{};
+// Kept open while asset_pak is replaced, so the old archive stays mapped
+// until everything loaded from the new one
+static PakArchive* asset_pak_spare{};
+
+#define ASSET_PAK_PATH "assets.pak"
+#define ATLAS_FILENAME "TEXTURE_ATLAS.png"
+
+// event.user.code of the file watcher's notifications
+enum WatchTag : i32 {
+    WATCH_TAG_GAME_DLL,
+    WATCH_TAG_ASSET_PAK,
+    WATCH_TAG_SHADERS,
+    WATCH_TAG_IMAGES,
+    WATCH_TAG_FONTS,
+};
+
+// user_data of the requests the frame loop submits to async_io
+enum AsyncTag : u64 {
+    ASYNC_TAG_ATLAS_STAT,
+    ASYNC_TAG_ATLAS_READ,
+};
+
+#define ATLAS_LOOSE_PATH "assets/images/" ATLAS_FILENAME
+
+// A changed loose atlas image is stat'ed and read through async_io, so the
+// frame loop never blocks on the file; only decoding and the upload run on
+// the frame that picks up the read.
+struct AtlasReload {
+    u8* data;       // SDL_malloc'd buffer the read fills; freed when it lands
+    bool in_flight; // A stat or read is outstanding
+    bool again;     // The image changed again while in flight
+};
+static AtlasReload atlas_reload{};
+
+// The game library is copied before loading so the build can overwrite the
+// original while the copy is in use. The copy alternates between two files
+// so the one being replaced is never the one that is loaded.
+static const char* const game_dll_copies[2] = {
+    DYNLIB("libgame_load0"),
+    DYNLIB("libgame_load1"),
+};
+
+struct GameDllReload {
+    SDL_SharedObject* dll;
+    u32 loaded_copy;         // Index into game_dll_copies of `dll`
+    u64 timestamp;           // Of the library currently loaded
+    u64 rejected_timestamp;  // Of a copied library that failed to load
+    bool pending;            // The watcher saw the library change
+};
+
+static GameDllReload game_dll_reload{};
+
+// Copy the next reload writes to, which is never the loaded one
+static u32 game_dll_next_copy() {
+    return game_dll_reload.dll ? 1 - game_dll_reload.loaded_copy : 0;
+}
 
-    u64 current_dll_timestamp = file_get_timestamp(DYNLIB("libgame"));
+// Little-endian field of a mapped file, or 0 past its end
+template <typename T>
+static T game_dll_field(const FileView& file, u64 offset) {
+    T value = 0;
+    if (offset <= file.size && sizeof(T) <= file.size - offset) {
+        SDL_memcpy(&value, file.data + offset, sizeof(T));
+    }
+    return value;
+}
+
+/**
+ * @brief Checks that a library copy holds every byte its headers point at.
+ *
+ * The copy only proves the file stopped changing, and a linker can pause
+ * between writes. Loading a library cut short crashes the loader instead of
+ * failing, so the section and segment tables are checked against the file
+ * size first. ELF and PE are checked; other formats are trusted.
+ *
+ * @param path The library copy.
+ * @return True if the library looks complete.
+ */
+static bool game_dll_is_complete(const char* path) {
+    FileView file;
+    if (!file.open(path)) return false;
+
+    auto covered = [&](u64 offset, u64 size) {
+        return offset <= file.size && size <= file.size - offset;
+    };
 
-    if (current_dll_timestamp > game_dll_timestamp) {
-        if (game_dll) {
-            SDL_UnloadObject(game_dll);
-            game_dll = nullptr;
-            SDL_Log("Unloaded old game dynlib");
+    if (game_dll_field<u32>(file, 0) == 0x464C457F) { // "\x7FELF", 64-bit only
+        u64 phoff = game_dll_field<u64>(file, 0x20);
+        u64 shoff = game_dll_field<u64>(file, 0x28);
+        u16 phentsize = game_dll_field<u16>(file, 0x36);
+        u16 phnum = game_dll_field<u16>(file, 0x38);
+        u16 shentsize = game_dll_field<u16>(file, 0x3A);
+        u16 shnum = game_dll_field<u16>(file, 0x3C);
+        if (!covered(phoff, (u64)phnum * phentsize) || !covered(shoff, (u64)shnum * shentsize)) {
+            return false;
         }
+        for (u16 i = 0; i < phnum; i++) {
+            u64 header = phoff + (u64)i * phentsize;
+            if (!covered(game_dll_field<u64>(file, header + 0x08), game_dll_field<u64>(file, header + 0x20))) {
+                return false;
+            }
+        }
+        for (u16 i = 0; i < shnum; i++) {
+            u64 header = shoff + (u64)i * shentsize;
+            bool no_bits = game_dll_field<u32>(file, header + 0x04) == 8; // SHT_NOBITS
+            if (!no_bits && !covered(game_dll_field<u64>(file, header + 0x18), game_dll_field<u64>(file, header + 0x20))) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        while (!copy_file(
-            transient_storage,
-            DYNLIB("libgame"),
-            DYNLIB("libgame_load")
-        )) {
-            SDL_Delay(10);
+    if (game_dll_field<u16>(file, 0) == 0x5A4D) { // "MZ"
+        u64 pe = game_dll_field<u32>(file, 0x3C);
+        u16 section_count = game_dll_field<u16>(file, pe + 6);
+        u64 sections = pe + 24 + game_dll_field<u16>(file, pe + 20);
+        if (game_dll_field<u32>(file, pe) != 0x00004550 || !covered(sections, (u64)section_count * 40)) {
+            return false;
+        }
+        for (u16 i = 0; i < section_count; i++) {
+            u64 section = sections + (u64)i * 40;
+            if (!covered(game_dll_field<u32>(file, section + 20), game_dll_field<u32>(file, section + 16))) {
+                return false;
+            }
         }
+        return true;
+    }
+
+    return true;
+}
 
-        game_dll = SDL_LoadObject(DYNLIB("libgame_load"));
-        if(!game_dll) {
-            SDL_Log("Failed to load game dynlib: %s", SDL_GetError());
-            return;
+/**
+ * @brief Swaps in the freshly copied game library. The old library is only
+ * unloaded once the new one resolved, so a broken build keeps the old code
+ * running.
+ * @return False if the library or its entry point could not be loaded.
+ */
+static bool load_game_dll(u32 copy) {
+    GameDllReload* reload = &game_dll_reload;
+
+    SDL_SharedObject* dll = SDL_LoadObject(game_dll_copies[copy]);
+    if (!dll) {
+        SDL_Log("Failed to load game dynlib: %s", SDL_GetError());
+        return false;
+    }
+
+    GameUpdateFn* update = (GameUpdateFn*)SDL_LoadFunction(dll, "game_update");
+    if (!update) {
+        SDL_Log("Failed to load game_update function: %s", SDL_GetError());
+        SDL_UnloadObject(dll);
+        return false;
+    }
+
+    if (reload->dll) {
+        SDL_UnloadObject(reload->dll);
+        SDL_Log("Unloaded old game dynlib");
+    }
+    reload->dll = dll;
+    reload->loaded_copy = copy;
+    game_update_ptr = update;
+    return true;
+}
+
+/**
+ * @brief Copies and loads the game library if it changed since it was
+ * loaded.
+ *
+ * The copy stays inside the kernel and is checked for completeness, so a
+ * library the linker is still writing is skipped and picked up on a later
+ * frame without waiting here; the reload stays pending until then.
+ *
+ * @return True if a new library was loaded.
+ */
+static bool reload_game_dll() {
+    GameDllReload* reload = &game_dll_reload;
+
+    u64 current_dll_timestamp = file_get_timestamp(DYNLIB("libgame"));
+    if (current_dll_timestamp <= reload->timestamp ||
+        current_dll_timestamp == reload->rejected_timestamp) {
+        reload->pending = false;
+        return false;
+    }
+
+    u64 copy_start = SDL_GetPerformanceCounter();
+    u32 copy = game_dll_next_copy();
+    FileCopyInfo info;
+    if (!copy_file(DYNLIB("libgame"), game_dll_copies[copy], &info) ||
+        !game_dll_is_complete(game_dll_copies[copy])) {
+        return false;
+    }
+    u64 copy_end = SDL_GetPerformanceCounter();
+
+    reload->pending = false;
+    if (!load_game_dll(copy)) {
+        // Not retried until the next build
+        reload->rejected_timestamp = info.modify_time;
+        return false;
+    }
+    reload->timestamp = info.modify_time;
+
+    // Measured from the linker's last write to the library, which is when
+    // the build finished
+    SDL_Time now = 0;
+    SDL_GetCurrentTime(&now);
+    f64 frequency = (f64)SDL_GetPerformanceFrequency();
+    SDL_Log(
+        "Reloaded game dynlib (%.2f MB) %.1f ms after the build finished, copy took %.2f ms",
+        (f64)info.size / MB(1),
+        (f64)((i64)now - (i64)info.modify_time) / 1e6,
+        (f64)(copy_end - copy_start) * 1000.0 / frequency
+    );
+    return true;
+}
+
+/**
+ * @brief Loads the game library before the first frame, which cannot run
+ * without it. Waits briefly in case a build is still writing it.
+ * @return False if the library is missing or fails to load.
+ */
+static bool load_initial_game_dll() {
+    if (!file_exists(DYNLIB("libgame"))) {
+        SDL_Log("Game dynlib not found: %s", DYNLIB("libgame"));
+        return false;
+    }
+
+    for (i32 attempt = 0; attempt < 100 && !game_update_ptr; attempt++) {
+        if (!reload_game_dll()) {
+            SDL_Delay(10);
         }
+    }
+    return game_update_ptr != nullptr;
+}
+
+/**
+ * @brief Swaps in a rebuilt asset archive and reloads everything read from
+ * it. A new archive that fails to open leaves the current one in use.
+ */
+static void reload_asset_pak() {
+    if (!asset_pak_spare->open(ASSET_PAK_PATH)) {
+        SDL_Log("Keeping the current assets");
+        return;
+    }
+
+    // The fonts read from the old mapping until they are reopened
+    renderer->unload_fonts();
+    PakArchive* previous = asset_pak;
+    asset_pak = asset_pak_spare;
+    asset_pak_spare = previous;
+
+    renderer->load_fonts();
+    renderer->reload_shaders();
+    sprite_atlas->reload_texture(ATLAS_FILENAME);
+    asset_pak_spare->close();
+    SDL_Log("Reloaded %s (%u entries)", ASSET_PAK_PATH, asset_pak->get_entry_count());
+}
 
-        game_update_ptr =
-            (GameUpdateFn*)SDL_LoadFunction(game_dll, "game_update");
-        if (!game_update_ptr) {
-            SDL_Log("Failed to load game_update function: %s", SDL_GetError());
-            return;
+/**
+ * @brief Watches the game library and the assets for hot reload. Loose
+ * asset directories are only watched while no archive is in use.
+ */
+static void watch_reloadable_files() {
+    file_watcher->watch(DYNLIB("libgame"), WATCH_TAG_GAME_DLL);
+    file_watcher->watch(ASSET_PAK_PATH, WATCH_TAG_ASSET_PAK);
+    if (asset_pak->is_open()) return;
+
+    if (file_exists("assets/shaders/compiled")) {
+        file_watcher->watch("assets/shaders/compiled", WATCH_TAG_SHADERS);
+    }
+    if (file_exists("assets/images")) {
+        file_watcher->watch("assets/images", WATCH_TAG_IMAGES);
+    }
+    if (file_exists("assets/fonts")) {
+        file_watcher->watch("assets/fonts", WATCH_TAG_FONTS);
+    }
+}
+
+/**
+ * @brief Starts reading the loose atlas image through async_io. A change
+ * that arrives while a read is outstanding is picked up once it lands.
+ */
+static void start_atlas_reload() {
+    if (atlas_reload.in_flight) {
+        atlas_reload.again = true;
+        return;
+    }
+    atlas_reload.again = false;
+    atlas_reload.in_flight = async_io->stat(ATLAS_LOOSE_PATH, ASYNC_TAG_ATLAS_STAT);
+    if (!atlas_reload.in_flight) {
+        SDL_Log("Async I/O queue full, atlas reload dropped");
+    }
+}
+
+/**
+ * @brief Handles the async_io requests that finished since the last frame.
+ */
+static void poll_async_io() {
+    AsyncIoCompletion completions[16];
+    usize count = async_io->poll(completions, SDL_arraysize(completions));
+    for (usize i = 0; i < count; i++) {
+        const AsyncIoCompletion& completion = completions[i];
+        switch (completion.user_data) {
+            case ASYNC_TAG_ATLAS_STAT:
+                atlas_reload.in_flight = false;
+                if (!completion.ok || completion.file_size == 0) {
+                    SDL_Log("Failed to stat %s", ATLAS_LOOSE_PATH);
+                    break;
+                }
+                atlas_reload.data = (u8*)SDL_malloc((usize)completion.file_size);
+                if (!atlas_reload.data) {
+                    SDL_Log("Failed to allocate %zu bytes for the atlas", (usize)completion.file_size);
+                    break;
+                }
+                atlas_reload.in_flight = async_io->read(
+                    ATLAS_LOOSE_PATH,
+                    atlas_reload.data,
+                    (usize)completion.file_size,
+                    0,
+                    ASYNC_TAG_ATLAS_READ
+                );
+                if (!atlas_reload.in_flight) {
+                    SDL_free(atlas_reload.data);
+                    atlas_reload.data = nullptr;
+                }
+                break;
+            case ASYNC_TAG_ATLAS_READ:
+                atlas_reload.in_flight = false;
+                if (completion.ok) {
+                    sprite_atlas->reload_texture_from_memory(atlas_reload.data, completion.bytes);
+                } else {
+                    SDL_Log("Failed to read %s", ATLAS_LOOSE_PATH);
+                }
+                SDL_free(atlas_reload.data);
+                atlas_reload.data = nullptr;
+                break;
         }
-        game_dll_timestamp = current_dll_timestamp;
+    }
+
+    // Coalesced changes restart from the stat, the file may have grown
+    if (atlas_reload.again && !atlas_reload.in_flight) {
+        start_atlas_reload();
+    }
+}
+
+/**
+ * @brief Applies a change the file watcher published. Runs from the event
+ * pump, between frames.
+ */
+static void handle_file_change(i32 tag) {
+    switch (tag) {
+        case WATCH_TAG_GAME_DLL:
+            // Loaded after the events, before this frame's game_update
+            game_dll_reload.pending = true;
+            break;
+        case WATCH_TAG_ASSET_PAK:
+            reload_asset_pak();
+            break;
+        case WATCH_TAG_SHADERS:
+            renderer->reload_shaders();
+            break;
+        case WATCH_TAG_IMAGES:
+            start_atlas_reload();
+            break;
+        case WATCH_TAG_FONTS:
+            renderer->reload_fonts();
+            break;
     }
 }
 
@@ -89,11 +438,20 @@ void poll_events() {
                 input->screen_size =
                     ivec2(event.window.data1, event.window.data2);
                 break;
+            default:
+                if (event.type == file_watcher->get_event_type()) {
+                    handle_file_change(event.user.code);
+                }
+                break;
         }
     }
 }
 
-static void update_window_title(f32 current_time) {
+static void update_window_title(
+    f32 current_time,
+    Arena* permanent_storage,
+    Arena* frame_arena
+) {
     // Update title every 0.5 seconds
     if (current_time - last_title_update_time < 0.5f) {
         return;
@@ -102,28 +460,53 @@ static void update_window_title(f32 current_time) {
 
     // Format title with FPS and memory usage
     char title[256];
-    SDL_snprintf(title, sizeof(title), "FPS: %.1f", fps);
+    SDL_snprintf(
+        title,
+        sizeof(title),
+        "FPS: %.1f | Permanent: %.2f MB | Frame peak: %.2f MB",
+        fps,
+        (f64)permanent_storage->get_total_used_size() / MB(1),
+        (f64)frame_arena->get_stats().peak_used / MB(1)
+    );
 
     SDL_SetWindowTitle(renderer->window, title);
 }
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
-    Arena transient_storage(MB(32));
-    Arena permanent_storage(MB(64));
+    // All arenas reserve address space up front and commit on demand, so
+    // they stay contiguous no matter how far they grow. They are touched
+    // every frame, so they ask for 2 MB pages to keep TLB misses down.
+    Arena permanent_storage(GB(1), true, ARENA_BACKEND_HUGE_PAGES);
+
+    // Per-frame memory is only reset once the GPU is done with its frame
+    FrameArenaRing frame_arenas{};
+    if (!frame_arenas.init(GB(1), MB(32), ARENA_BACKEND_HUGE_PAGES)) {
+        SDL_Log("Failed to initialize frame arenas");
+        return EXIT_FAILURE;
+    }
 
     SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
     TTF_Init();
 
     defer {
+        permanent_storage.log_stats("permanent_storage");
+        frame_arenas.log_stats();
+        frame_arenas.cleanup(renderer ? renderer->device : nullptr);
         if (sprite_atlas) sprite_atlas->cleanup();
         if (renderer) renderer->cleanup();
-        transient_storage.destroy();
+        if (asset_pak) asset_pak->close();
+        if (asset_pak_spare) asset_pak_spare->close();
+        if (file_watcher) file_watcher->shutdown();
+        if (async_io) async_io->shutdown();
+        SDL_free(atlas_reload.data);
         permanent_storage.destroy();
+        release_scratch_arenas();
 
         TTF_Init();
         SDL_Quit();
     };
 
+    permanent_storage.set_tag("GameState");
     game_state = permanent_storage.push_struct<GameState>();
     if(!game_state) {
         SDL_Log("Failed to initialize game_state");
@@ -131,27 +514,64 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
     }
     game_state->register_keymaps();
 
+    permanent_storage.set_tag("Input");
     input = permanent_storage.push_struct<Input>();
 
+    // Assets come from one mapped archive when the build produced it
+    permanent_storage.set_tag("Assets");
+    asset_pak = permanent_storage.push_struct<PakArchive>();
+    asset_pak_spare = permanent_storage.push_struct<PakArchive>();
+    if (!asset_pak || !asset_pak_spare) {
+        SDL_Log("Failed to allocate asset archives");
+        return EXIT_FAILURE;
+    }
+    if (!asset_pak->open(ASSET_PAK_PATH)) {
+        SDL_Log("No usable assets.pak, loading loose files from assets/");
+    }
+
+    permanent_storage.set_tag("Renderer");
     renderer = permanent_storage.push_struct<Renderer>();
-    if (!renderer || !renderer->init()) {
+    if (!renderer || !renderer->init(&permanent_storage)) {
         SDL_Log("Failed to initialize renderer");
         return EXIT_FAILURE;
     }
 
-    if (!renderer->init_text("assets/fonts/dejavu.ttf")) {
+    if (!renderer->init_text("fonts/dejavu.ttf")) {
         SDL_Log("Failed to initialize text_renderer");
         return EXIT_FAILURE;
     }
 
+    permanent_storage.set_tag("SpriteAtlas");
     sprite_atlas = permanent_storage.push_struct<SpriteAtlas>();
-    if (!sprite_atlas || !sprite_atlas->init("TEXTURE_ATLAS.png")) {
+    if (!sprite_atlas || !sprite_atlas->init(&permanent_storage, ATLAS_FILENAME)) {
         SDL_Log("Failed to initialize sprite_atlas");
         return EXIT_FAILURE;
     }
 
     sprite_atlas->register_sprites();
 
+    permanent_storage.set_tag("AsyncIo");
+    async_io = permanent_storage.push_struct<AsyncIo>();
+    if (!async_io || !async_io->init(&permanent_storage)) {
+        SDL_Log("Failed to initialize async I/O");
+        return EXIT_FAILURE;
+    }
+
+    if (!load_initial_game_dll()) {
+        SDL_Log("Failed to load game dynlib");
+        return EXIT_FAILURE;
+    }
+
+    // Reloads are driven by change notifications instead of checking file
+    // times every frame
+    permanent_storage.set_tag("FileWatcher");
+    file_watcher = permanent_storage.push_struct<FileWatcher>();
+    if (!file_watcher || !file_watcher->init()) {
+        SDL_Log("Failed to start file watcher");
+        return EXIT_FAILURE;
+    }
+    watch_reloadable_files();
+
     SDL_ShowWindow(renderer->window);
 
     u64 last_time = SDL_GetPerformanceCounter();
@@ -174,17 +594,26 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
             frame_count = 0;
         }
 
-        f32 current_time_seconds = (f32)frame_start / frequency;
-        update_window_title(current_time_seconds);
+        Arena* frame_arena = frame_arenas.begin_frame(renderer->device);
 
-        reload_game_dll(&transient_storage);
+        f32 current_time_seconds = (f32)frame_start / frequency;
+        update_window_title(
+            current_time_seconds,
+            &permanent_storage,
+            frame_arena
+        );
 
         input->begin_frame();
 
         poll_events();
+        poll_async_io();
+
+        if (game_dll_reload.pending) {
+            reload_game_dll();
+        }
 
         game_update(game_state, input, sprite_atlas, renderer);
-        renderer->render();
+        frame_arenas.end_frame(renderer->render(frame_arena));
 
         if (game_state->fps_cap) {
             u64 frame_end = SDL_GetPerformanceCounter();
@@ -202,8 +631,6 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
                 }
             }
         }
-
-        transient_storage.clear();
     }
 
     return EXIT_SUCCESS;
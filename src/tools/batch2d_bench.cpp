@@ -0,0 +1,556 @@
+// Checks that the batch2d kernels picked at run time (AVX2 or NEON) give
+// the same results as the scalar kernels, over every length around the
+// vector width, unaligned starts and aliased outputs. The rect kernels are
+// also checked against brute force over rect2, and overlap pairs against
+// an O(n^2) pass over every pair. Then times the kernels against the
+// scalar ones. Build and run from the repository root:
+//
+//   zig c++ -std=c++23 -O2 -ffp-contract=off -Isrc src/tools/batch2d_bench.cpp -o batch2d_bench -lSDL3
+//   ./batch2d_bench
+//
+// -ffp-contract=off keeps the compiler from fusing the scalar kernels into
+// FMAs, which the vector kernels do not use. Inputs are finite: min and max
+// order NaNs differently per instruction set. Exits with failure on the
+// first mismatch.
+#include "core/types.h"
+#include "core/utils.h"
+#include "core/batch2d.cpp"
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+
+// Every length up to this is checked, to cover each tail size
+#define BATCH2D_BENCH_SHORT_LENGTHS 64
+#define BATCH2D_BENCH_RANDOM_CASES 2000
+#define BATCH2D_BENCH_MAX_LENGTH 1024
+#define BATCH2D_BENCH_PAIR_CASES 200
+// Rects per overlap pairs case; the brute force is quadratic
+#define BATCH2D_BENCH_MAX_PAIR_RECTS 400
+#define BATCH2D_BENCH_MAX_PAIRS (BATCH2D_BENCH_MAX_PAIR_RECTS * BATCH2D_BENCH_MAX_PAIR_RECTS / 2)
+// Elements per timed pass; small enough to stay in L1
+#define BATCH2D_BENCH_BATCH 1024
+#define BATCH2D_BENCH_MIN_SECONDS 0.25
+
+struct Rng {
+    u64 state;
+
+    u64 next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    // Uniform in [-range, range)
+    f32 uniform(f32 range) {
+        return ((f32)(next() >> 40) / (f32)(1 << 24) * 2.0f - 1.0f) * range;
+    }
+    // Uniform in [0, count)
+    usize below(usize count) {
+        return (usize)(next() % count);
+    }
+    // Whole numbers in [-range, range], so rect edges often coincide
+    f32 grid(f32 range) {
+        return SDL_roundf(uniform(range));
+    }
+};
+
+// Input and output streams, with slack so starts can be misaligned
+struct Streams {
+    f32 x[BATCH2D_BENCH_MAX_LENGTH + 8];
+    f32 y[BATCH2D_BENCH_MAX_LENGTH + 8];
+    f32 w[BATCH2D_BENCH_MAX_LENGTH + 8];
+    f32 h[BATCH2D_BENCH_MAX_LENGTH + 8];
+};
+
+static Streams input;
+static Streams expected;
+static Streams actual;
+static u32 expected_indices[BATCH2D_BENCH_MAX_LENGTH];
+static u32 actual_indices[BATCH2D_BENCH_MAX_LENGTH];
+
+static void fill(Rng* rng, f32 range) {
+    for (usize i = 0; i < BATCH2D_BENCH_MAX_LENGTH + 8; i++) {
+        input.x[i] = rng->uniform(range);
+        input.y[i] = rng->uniform(range);
+        input.w[i] = rng->uniform(range);
+        input.h[i] = rng->uniform(range);
+    }
+}
+
+/**
+ * @brief Fills the input with rects as min_x, min_y, max_x and max_y in
+ * the x, y, w and h streams, on a whole-number grid so touching edges are
+ * common. Some rects are empty.
+ */
+static void fill_rects(Rng* rng, f32 range, f32 max_size) {
+    for (usize i = 0; i < BATCH2D_BENCH_MAX_LENGTH + 8; i++) {
+        input.x[i] = rng->grid(range);
+        input.y[i] = rng->grid(range);
+        input.w[i] = input.x[i] + SDL_fabsf(rng->grid(max_size));
+        input.h[i] = input.y[i] + SDL_fabsf(rng->grid(max_size));
+    }
+}
+
+static rect2 input_rect(usize i) {
+    return rect2(vec2(input.x[i], input.y[i]), vec2(input.w[i], input.h[i]));
+}
+
+static bool same_bits(f32 a, f32 b) {
+    u32 bits_a, bits_b;
+    SDL_memcpy(&bits_a, &a, sizeof(a));
+    SDL_memcpy(&bits_b, &b, sizeof(b));
+    return bits_a == bits_b;
+}
+
+/**
+ * @brief Compares `count` floats bit for bit and logs the first difference.
+ */
+static bool same_stream(const char* kernel, const char* stream, const f32* a, const f32* b, usize count, usize start) {
+    for (usize i = 0; i < count; i++) {
+        if (!same_bits(a[i], b[i])) {
+            SDL_Log(
+                "%s differs from scalar in %s[%zu] (length %zu, start %zu): %a vs %a",
+                kernel,
+                stream,
+                i,
+                count,
+                start,
+                a[i],
+                b[i]
+            );
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs each vec2 kernel through the dispatcher and through the
+ * scalar kernels on one length and start offset.
+ * @return False on the first mismatch, after logging it.
+ */
+static bool check_vec2_case(Rng* rng, usize count, usize start) {
+    const Batch2dKernels& scalar = batch2d_scalar_kernels;
+    affine2 xf{rng->uniform(4.0f), rng->uniform(4.0f), rng->uniform(100.0f),
+               rng->uniform(4.0f), rng->uniform(4.0f), rng->uniform(100.0f)};
+    const f32* xs = input.x + start;
+    const f32* ys = input.y + start;
+
+    scalar.transform_points(xf, xs, ys, expected.x, expected.y, count);
+    batch_transform_points(xf, xs, ys, actual.x, actual.y, count);
+    if (!same_stream("transform_points", "x", actual.x, expected.x, count, start) ||
+        !same_stream("transform_points", "y", actual.y, expected.y, count, start)) {
+        return false;
+    }
+
+    // Outputs may alias the inputs
+    SDL_memcpy(actual.x, xs, count * sizeof(f32));
+    SDL_memcpy(actual.y, ys, count * sizeof(f32));
+    batch_transform_points(xf, actual.x, actual.y, actual.x, actual.y, count);
+    if (!same_stream("transform_points in place", "x", actual.x, expected.x, count, start) ||
+        !same_stream("transform_points in place", "y", actual.y, expected.y, count, start)) {
+        return false;
+    }
+
+    vec2 offset(rng->uniform(100.0f), rng->uniform(100.0f));
+    vec2 scale(rng->uniform(4.0f), rng->uniform(4.0f));
+    SDL_memcpy(expected.x, xs, count * sizeof(f32));
+    SDL_memcpy(expected.y, ys, count * sizeof(f32));
+    SDL_memcpy(expected.w, input.w + start, count * sizeof(f32));
+    SDL_memcpy(expected.h, input.h + start, count * sizeof(f32));
+    actual = expected;
+    scalar.offset_scale_rects(expected.x, expected.y, expected.w, expected.h, count, offset, scale);
+    batch_offset_scale_rects(actual.x, actual.y, actual.w, actual.h, count, offset, scale);
+    if (!same_stream("offset_scale_rects", "x", actual.x, expected.x, count, start) ||
+        !same_stream("offset_scale_rects", "y", actual.y, expected.y, count, start) ||
+        !same_stream("offset_scale_rects", "w", actual.w, expected.w, count, start) ||
+        !same_stream("offset_scale_rects", "h", actual.h, expected.h, count, start)) {
+        return false;
+    }
+
+    f32 t = rng->uniform(1.5f);
+    scalar.lerp(xs, ys, t, expected.x, count);
+    batch_lerp(xs, ys, t, actual.x, count);
+    if (!same_stream("lerp", "out", actual.x, expected.x, count, start)) {
+        return false;
+    }
+    SDL_memcpy(actual.x, xs, count * sizeof(f32));
+    batch_lerp(actual.x, ys, t, actual.x, count);
+    if (!same_stream("lerp in place", "out", actual.x, expected.x, count, start)) {
+        return false;
+    }
+
+    // Compared by value: the lane reduction may pick either zero of a tie
+    vec2 min, max;
+    bool found = batch_bounds(xs, ys, count, &min, &max);
+    if (found != (count != 0)) {
+        SDL_Log("bounds returned %d for length %zu", found, count);
+        return false;
+    }
+    if (found) {
+        vec2 expected_min(xs[0], ys[0]);
+        vec2 expected_max = expected_min;
+        scalar.bounds(xs, ys, count, &expected_min, &expected_max);
+        if (min.x != expected_min.x || min.y != expected_min.y ||
+            max.x != expected_max.x || max.y != expected_max.y) {
+            SDL_Log(
+                "bounds differs from scalar (length %zu, start %zu): (%a, %a)-(%a, %a) vs (%a, %a)-(%a, %a)",
+                count,
+                start,
+                min.x,
+                min.y,
+                max.x,
+                max.y,
+                expected_min.x,
+                expected_min.y,
+                expected_max.x,
+                expected_max.y
+            );
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks every short length at every start offset, then random
+ * lengths and starts.
+ */
+static bool check_vec2() {
+    Rng rng{0x9E3779B97F4A7C15ull};
+    fill(&rng, 1000.0f);
+
+    u32 cases = 0;
+    for (usize count = 0; count <= BATCH2D_BENCH_SHORT_LENGTHS; count++) {
+        for (usize start = 0; start < 8; start++, cases++) {
+            if (!check_vec2_case(&rng, count, start)) return false;
+        }
+    }
+    for (u32 n = 0; n < BATCH2D_BENCH_RANDOM_CASES; n++, cases++) {
+        if (n % 64 == 0) fill(&rng, n % 128 == 0 ? 1e6f : 1.0f);
+        usize count = rng.below(BATCH2D_BENCH_MAX_LENGTH + 1);
+        if (!check_vec2_case(&rng, count, rng.below(8))) return false;
+    }
+
+    SDL_Log("vec2 kernels: %u cases match the scalar kernels", cases);
+    return true;
+}
+
+/**
+ * @brief Compares the hit lists of the dispatched kernel, the scalar kernel
+ * and a brute-force pass over rect2.
+ */
+static bool same_hits(
+    const char* kernel,
+    usize hits,
+    usize scalar_hits,
+    usize brute_hits,
+    const u32* brute_indices,
+    usize count,
+    usize start
+) {
+    if (hits != scalar_hits || hits != brute_hits) {
+        SDL_Log(
+            "%s found %zu hits, scalar %zu, brute force %zu (length %zu, start %zu)",
+            kernel,
+            hits,
+            scalar_hits,
+            brute_hits,
+            count,
+            start
+        );
+        return false;
+    }
+    for (usize k = 0; k < hits; k++) {
+        if (actual_indices[k] != expected_indices[k] || actual_indices[k] != brute_indices[k]) {
+            SDL_Log(
+                "%s hit %zu is rect %u, scalar %u, brute force %u (length %zu, start %zu)",
+                kernel,
+                k,
+                actual_indices[k],
+                expected_indices[k],
+                brute_indices[k],
+                count,
+                start
+            );
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs each per-rect kernel through the dispatcher, through the
+ * scalar kernels and as a loop over rect2 on one length and start offset.
+ * @return False on the first mismatch, after logging it.
+ */
+static bool check_rect_case(Rng* rng, usize count, usize start) {
+    static u32 brute_indices[BATCH2D_BENCH_MAX_LENGTH];
+    const Batch2dKernels& scalar = batch2d_scalar_kernels;
+    const f32* min_xs = input.x + start;
+    const f32* min_ys = input.y + start;
+    const f32* max_xs = input.w + start;
+    const f32* max_ys = input.h + start;
+
+    vec2 corner(rng->grid(100.0f), rng->grid(100.0f));
+    rect2 r(corner, corner + vec2(SDL_fabsf(rng->grid(40.0f)), SDL_fabsf(rng->grid(40.0f))));
+    usize hits = batch_rects_overlap(r, min_xs, min_ys, max_xs, max_ys, count, actual_indices);
+    usize scalar_hits = scalar.rects_overlap(r, min_xs, min_ys, max_xs, max_ys, count, expected_indices);
+    usize brute_hits = 0;
+    for (usize i = 0; i < count; i++) {
+        if (input_rect(start + i).overlaps(r)) brute_indices[brute_hits++] = (u32)i;
+    }
+    if (!same_hits("rects_overlap", hits, scalar_hits, brute_hits, brute_indices, count, start)) {
+        return false;
+    }
+
+    vec2 p(rng->grid(100.0f), rng->grid(100.0f));
+    hits = batch_rects_contain_point(p, min_xs, min_ys, max_xs, max_ys, count, actual_indices);
+    scalar_hits = scalar.rects_contain_point(p, min_xs, min_ys, max_xs, max_ys, count, expected_indices);
+    brute_hits = 0;
+    for (usize i = 0; i < count; i++) {
+        if (input_rect(start + i).contains(p)) brute_indices[brute_hits++] = (u32)i;
+    }
+    if (!same_hits("rects_contain_point", hits, scalar_hits, brute_hits, brute_indices, count, start)) {
+        return false;
+    }
+
+    rect2 merged;
+    bool found = batch_rects_merge(min_xs, min_ys, max_xs, max_ys, count, &merged);
+    if (found != (count != 0)) {
+        SDL_Log("rects_merge returned %d for length %zu", found, count);
+        return false;
+    }
+    if (found) {
+        rect2 brute_merged = input_rect(start);
+        for (usize i = 1; i < count; i++) {
+            brute_merged = brute_merged.merged(input_rect(start + i));
+        }
+        if (merged.min.x != brute_merged.min.x || merged.min.y != brute_merged.min.y ||
+            merged.max.x != brute_merged.max.x || merged.max.y != brute_merged.max.y) {
+            SDL_Log(
+                "rects_merge differs from brute force (length %zu, start %zu): (%g, %g)-(%g, %g) vs (%g, %g)-(%g, %g)",
+                count,
+                start,
+                merged.min.x,
+                merged.min.y,
+                merged.max.x,
+                merged.max.y,
+                brute_merged.min.x,
+                brute_merged.min.y,
+                brute_merged.max.x,
+                brute_merged.max.y
+            );
+            return false;
+        }
+    }
+
+    vec2 margin(rng->uniform(8.0f), rng->uniform(8.0f));
+    SDL_memcpy(expected.x, min_xs, count * sizeof(f32));
+    SDL_memcpy(expected.y, min_ys, count * sizeof(f32));
+    SDL_memcpy(expected.w, max_xs, count * sizeof(f32));
+    SDL_memcpy(expected.h, max_ys, count * sizeof(f32));
+    actual = expected;
+    scalar.rects_expand(expected.x, expected.y, expected.w, expected.h, count, margin);
+    batch_rects_expand(actual.x, actual.y, actual.w, actual.h, count, margin);
+    if (!same_stream("rects_expand", "min_x", actual.x, expected.x, count, start) ||
+        !same_stream("rects_expand", "min_y", actual.y, expected.y, count, start) ||
+        !same_stream("rects_expand", "max_x", actual.w, expected.w, count, start) ||
+        !same_stream("rects_expand", "max_y", actual.h, expected.h, count, start)) {
+        return false;
+    }
+    for (usize i = 0; i < count; i++) {
+        rect2 brute_expanded = input_rect(start + i).expanded(margin);
+        if (!same_bits(actual.x[i], brute_expanded.min.x) || !same_bits(actual.y[i], brute_expanded.min.y) ||
+            !same_bits(actual.w[i], brute_expanded.max.x) || !same_bits(actual.h[i], brute_expanded.max.y)) {
+            SDL_Log("rects_expand differs from rect2::expanded at %zu (length %zu, start %zu)", i, count, start);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the overlapping pairs among `count` rects sorted by min_x
+ * with batch_rects_overlap_pairs and checks them against every pair
+ * tested with rect2::overlaps, in the same order. Also checks that a short
+ * output buffer gets a prefix of the pairs and the full count.
+ */
+static bool check_pairs_case(Rng* rng, usize count) {
+    static RectPair pairs[BATCH2D_BENCH_MAX_PAIRS];
+    static RectPair brute_pairs[BATCH2D_BENCH_MAX_PAIRS];
+
+    // The sweep needs rects sorted by min_x; the other streams stay random
+    std::sort(input.x, input.x + count);
+    for (usize i = 0; i < count; i++) {
+        input.w[i] = input.x[i] + SDL_fabsf(rng->grid(24.0f));
+    }
+
+    usize brute_count = 0;
+    for (usize a = 0; a < count; a++) {
+        for (usize b = a + 1; b < count; b++) {
+            if (input_rect(a).overlaps(input_rect(b))) {
+                brute_pairs[brute_count++] = {(u32)a, (u32)b};
+            }
+        }
+    }
+
+    usize pair_count =
+        batch_rects_overlap_pairs(input.x, input.y, input.w, input.h, count, pairs, BATCH2D_BENCH_MAX_PAIRS);
+    if (pair_count != brute_count) {
+        SDL_Log("rects_overlap_pairs found %zu pairs, brute force %zu (%zu rects)", pair_count, brute_count, count);
+        return false;
+    }
+    for (usize k = 0; k < pair_count; k++) {
+        if (pairs[k].a != brute_pairs[k].a || pairs[k].b != brute_pairs[k].b) {
+            SDL_Log(
+                "rects_overlap_pairs pair %zu is (%u, %u), brute force (%u, %u) (%zu rects)",
+                k,
+                pairs[k].a,
+                pairs[k].b,
+                brute_pairs[k].a,
+                brute_pairs[k].b,
+                count
+            );
+            return false;
+        }
+    }
+
+    usize max_pairs = brute_count / 2;
+    SDL_memset(pairs, 0xFF, sizeof(RectPair) * (max_pairs + 1));
+    pair_count = batch_rects_overlap_pairs(input.x, input.y, input.w, input.h, count, pairs, max_pairs);
+    bool prefix = pair_count == brute_count && pairs[max_pairs].a == UINT32_MAX;
+    for (usize k = 0; prefix && k < max_pairs; k++) {
+        prefix = pairs[k].a == brute_pairs[k].a && pairs[k].b == brute_pairs[k].b;
+    }
+    if (!prefix) {
+        SDL_Log("rects_overlap_pairs with room for %zu of %zu pairs returned %zu", max_pairs, brute_count, pair_count);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks the rect kernels like the vec2 ones, then overlap pairs on
+ * random sets of sorted rects, dense and sparse.
+ */
+static bool check_rects() {
+    Rng rng{0xD1B54A32D192ED03ull};
+    fill_rects(&rng, 100.0f, 40.0f);
+
+    u32 cases = 0;
+    for (usize count = 0; count <= BATCH2D_BENCH_SHORT_LENGTHS; count++) {
+        for (usize start = 0; start < 8; start++, cases++) {
+            if (!check_rect_case(&rng, count, start)) return false;
+        }
+    }
+    for (u32 n = 0; n < BATCH2D_BENCH_RANDOM_CASES; n++, cases++) {
+        if (n % 64 == 0) fill_rects(&rng, n % 128 == 0 ? 1000.0f : 100.0f, 40.0f);
+        usize count = rng.below(BATCH2D_BENCH_MAX_LENGTH + 1);
+        if (!check_rect_case(&rng, count, rng.below(8))) return false;
+    }
+
+    u32 pair_cases = 0;
+    for (u32 n = 0; n < BATCH2D_BENCH_PAIR_CASES; n++, pair_cases++) {
+        fill_rects(&rng, n % 2 ? 1000.0f : 100.0f, 24.0f);
+        if (!check_pairs_case(&rng, rng.below(BATCH2D_BENCH_MAX_PAIR_RECTS + 1))) return false;
+    }
+
+    SDL_Log(
+        "Rect kernels: %u cases match the scalar kernels and rect2, %u overlap pair sets match brute force",
+        cases,
+        pair_cases
+    );
+    return true;
+}
+
+static f64 seconds_since(u64 start) {
+    return (f64)(SDL_GetPerformanceCounter() - start) / (f64)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * @brief Repeats `f`, one pass over the batch, until a run lasts long
+ * enough to time, and returns the fastest of 5 runs in nanoseconds per
+ * element.
+ */
+template <typename F> static f64 time_ns(F&& f) {
+    u32 calls = 1;
+    for (;;) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        if (seconds_since(start) >= BATCH2D_BENCH_MIN_SECONDS / 5) break;
+        calls *= 2;
+    }
+
+    f64 best = 1e30;
+    for (u32 run = 0; run < 5; run++) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        best = SDL_min(best, seconds_since(start) / calls);
+    }
+    return best * 1e9 / BATCH2D_BENCH_BATCH;
+}
+
+static void report(const char* name, f64 simd_ns, f64 scalar_ns) {
+    SDL_Log("  %-22s %6.3f ns vs %6.3f ns scalar (%.2fx)", name, simd_ns, scalar_ns, scalar_ns / simd_ns);
+}
+
+/**
+ * @brief Times the dispatched kernels against the scalar ones over a batch.
+ */
+static void bench() {
+    static f32 xs[BATCH2D_BENCH_BATCH], ys[BATCH2D_BENCH_BATCH];
+    static f32 ws[BATCH2D_BENCH_BATCH], hs[BATCH2D_BENCH_BATCH];
+    static f32 out_xs[BATCH2D_BENCH_BATCH], out_ys[BATCH2D_BENCH_BATCH];
+
+    Rng rng{12345};
+    for (usize i = 0; i < BATCH2D_BENCH_BATCH; i++) {
+        xs[i] = rng.uniform(1000.0f);
+        ys[i] = rng.uniform(1000.0f);
+        ws[i] = rng.uniform(100.0f);
+        hs[i] = rng.uniform(100.0f);
+    }
+    const Batch2dKernels& scalar = batch2d_scalar_kernels;
+    affine2 xf{1.5f, 0.25f, 10.0f, -0.25f, 1.5f, -20.0f};
+    usize n = BATCH2D_BENCH_BATCH;
+    vec2 min, max;
+
+    SDL_Log("Per element, batch of %d, %s kernels:", BATCH2D_BENCH_BATCH, batch2d_backend_name());
+    report(
+        "transform_points",
+        time_ns([&] { batch_transform_points(xf, xs, ys, out_xs, out_ys, n); }),
+        time_ns([&] { scalar.transform_points(xf, xs, ys, out_xs, out_ys, n); })
+    );
+    // Scale 1, offset 0 keeps the streams from drifting between passes
+    report(
+        "offset_scale_rects",
+        time_ns([&] { batch_offset_scale_rects(xs, ys, ws, hs, n, vec2(0.0f), vec2(1.0f)); }),
+        time_ns([&] { scalar.offset_scale_rects(xs, ys, ws, hs, n, vec2(0.0f), vec2(1.0f)); })
+    );
+    report(
+        "lerp",
+        time_ns([&] { batch_lerp(xs, ys, 0.3f, out_xs, n); }),
+        time_ns([&] { scalar.lerp(xs, ys, 0.3f, out_xs, n); })
+    );
+    report(
+        "bounds",
+        time_ns([&] { batch_bounds(xs, ys, n, &min, &max); }),
+        time_ns([&] {
+            min = max = vec2(xs[0], ys[0]);
+            scalar.bounds(xs, ys, n, &min, &max);
+        })
+    );
+
+    // Keeps the stores above from being discarded
+    volatile f32 sink = out_xs[0] + out_ys[0] + ws[0] + hs[0] + min.x + max.y;
+    (void)sink;
+}
+
+int main() {
+    SDL_Log("batch2d kernels: %s", batch2d_backend_name());
+    if (!check_vec2() || !check_rects()) {
+        return EXIT_FAILURE;
+    }
+    bench();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,277 @@
+// Enforces the error bounds documented in core/fastmath.h and measures the
+// speedups over libm. Each function is swept over its documented domain
+// against libm in double precision, the batch form is checked to match the
+// scalar form bit for bit, and both are timed against the float libm call.
+// Build and run from the repository root:
+//
+//   zig c++ -std=c++23 -O2 -Isrc src/tools/fastmath_bench.cpp -o fastmath_bench -lSDL3
+//   ./fastmath_bench
+//
+// Exits with failure if any bound is exceeded or the two forms disagree.
+#include "core/types.h"
+#include "core/utils.h"
+#include "core/fastmath.cpp"
+#include <SDL3/SDL.h>
+
+#include <float.h>
+#include <math.h>
+
+// Inputs checked per function
+#define FASTMATH_BENCH_SAMPLES (1u << 24)
+// Inputs per batch call, during the sweep and the timing
+#define FASTMATH_BENCH_CHUNK 4096
+#define FASTMATH_BENCH_MIN_SECONDS 0.25
+#define FASTMATH_BENCH_PI 3.14159265358979323846
+
+static f32 f32_from_bits(u32 bits) {
+    f32 value;
+    SDL_memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static u32 f32_to_bits(f32 value) {
+    u32 bits;
+    SDL_memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Deterministic per-sample hash, so inputs do not depend on chunking
+static u64 sample_hash(u64 i) {
+    i ^= i >> 33;
+    i *= 0xFF51AFD7ED558CCDull;
+    i ^= i >> 33;
+    i *= 0xC4CEB9FE1A85EC53ull;
+    return i ^ (i >> 33);
+}
+
+// Fraction of the way through the sweep, in [0, 1)
+static f64 sample_t(u64 i) {
+    return (f64)i / FASTMATH_BENCH_SAMPLES;
+}
+
+/**
+ * @brief One fastmath function with its documented bound, its reference
+ * and the input generator for its domain. Unary functions ignore `b`.
+ */
+struct FastFunction {
+    const char* name;
+    f64 bound;
+    bool relative; // Bound is on relative rather than absolute error
+    void (*input)(u64 i, f32* a, f32* b);
+    f32 (*fast)(f32 a, f32 b);
+    void (*fast_n)(const f32* a, const f32* b, f32* out, usize count);
+    f64 (*reference)(f64 a, f64 b);
+    f32 (*libm)(f32 a, f32 b);
+};
+
+/**
+ * @brief Sin and cos inputs: half evenly spaced over [-1e4, 1e4], half
+ * every stride-th float of magnitude up to 1e4 so small inputs are dense.
+ */
+static void trig_input(u64 i, f32* a, f32*) {
+    if (i % 2 == 0) {
+        *a = (f32)(-1e4 + 2e4 * sample_t(i));
+    } else {
+        u32 bits = (u32)(sample_t(i) * f32_to_bits(1e4f));
+        *a = f32_from_bits(bits | (sample_hash(i) & 1 ? 0x80000000u : 0));
+    }
+}
+
+static const FastFunction functions[] = {
+    {
+        "fast_rsqrt", 5e-6, true,
+        // Every stride-th float in [FLT_MIN, FLT_MAX]
+        [](u64 i, f32* a, f32*) {
+            u32 first = f32_to_bits(FLT_MIN);
+            u32 last = f32_to_bits(FLT_MAX);
+            *a = f32_from_bits(first + (u32)(sample_t(i) * (last - first)));
+        },
+        [](f32 a, f32) { return fast_rsqrt(a); },
+        [](const f32* a, const f32*, f32* out, usize count) { fast_rsqrt_n(a, out, count); },
+        [](f64 a, f64) { return 1.0 / sqrt(a); },
+        [](f32 a, f32) { return 1.0f / sqrtf(a); },
+    },
+    {
+        "fast_sin", 5e-7, false,
+        trig_input,
+        [](f32 a, f32) { return fast_sin(a); },
+        [](const f32* a, const f32*, f32* out, usize count) { fast_sin_n(a, out, count); },
+        [](f64 a, f64) { return sin(a); },
+        [](f32 a, f32) { return sinf(a); },
+    },
+    {
+        "fast_cos", 5e-7, false,
+        trig_input,
+        [](f32 a, f32) { return fast_cos(a); },
+        [](const f32* a, const f32*, f32* out, usize count) { fast_cos_n(a, out, count); },
+        [](f64 a, f64) { return cos(a); },
+        [](f32 a, f32) { return cosf(a); },
+    },
+    {
+        "fast_atan2", 3e-6, false,
+        // Half around the circle at magnitudes from 1e-30 to 1e30, half
+        // arbitrary finite pairs. The origin is left out: fast_atan2 takes
+        // it as 0 for either sign of zero, where libm gives 0 or pi
+        [](u64 i, f32* y, f32* x) {
+            u64 h = sample_hash(i);
+            if (i % 2 == 0) {
+                f64 angle = FASTMATH_BENCH_PI * (2.0 * sample_t(i) - 1.0);
+                f64 radius = pow(10.0, (f64)(h % 61) - 30.0);
+                *y = (f32)(radius * sin(angle));
+                *x = (f32)(radius * cos(angle));
+            } else {
+                *y = f32_from_bits((u32)h);
+                *x = f32_from_bits((u32)(h >> 32));
+                if (!isfinite(*y)) *y = 0.0f;
+                if (!isfinite(*x) || (*x == 0.0f && *y == 0.0f)) *x = -1.0f;
+            }
+        },
+        [](f32 y, f32 x) { return fast_atan2(y, x); },
+        [](const f32* y, const f32* x, f32* out, usize count) { fast_atan2_n(y, x, out, count); },
+        [](f64 y, f64 x) { return atan2(y, x); },
+        [](f32 y, f32 x) { return atan2f(y, x); },
+    },
+    {
+        "fast_exp", 1e-7, true,
+        [](u64 i, f32* a, f32*) {
+            *a = (f32)(-87.0 + 175.0 * sample_t(i));
+        },
+        [](f32 a, f32) { return fast_exp(a); },
+        [](const f32* a, const f32*, f32* out, usize count) { fast_exp_n(a, out, count); },
+        [](f64 a, f64) { return exp(a); },
+        [](f32 a, f32) { return expf(a); },
+    },
+};
+
+/**
+ * @brief Sweeps one function's domain, tracking the largest error against
+ * the double-precision reference and comparing batch with scalar results.
+ * @return False if the documented bound is exceeded or the forms differ.
+ */
+static bool check_accuracy(const FastFunction& f) {
+    static f32 a[FASTMATH_BENCH_CHUNK];
+    static f32 b[FASTMATH_BENCH_CHUNK];
+    static f32 out[FASTMATH_BENCH_CHUNK];
+
+    f64 max_error = 0.0;
+    f32 worst_a = 0.0f;
+    f32 worst_b = 0.0f;
+    for (u64 start = 0; start < FASTMATH_BENCH_SAMPLES; start += FASTMATH_BENCH_CHUNK) {
+        for (usize j = 0; j < FASTMATH_BENCH_CHUNK; j++) {
+            b[j] = 0.0f;
+            f.input(start + j, &a[j], &b[j]);
+        }
+        f.fast_n(a, b, out, FASTMATH_BENCH_CHUNK);
+
+        for (usize j = 0; j < FASTMATH_BENCH_CHUNK; j++) {
+            f32 scalar = f.fast(a[j], b[j]);
+            if (f32_to_bits(scalar) != f32_to_bits(out[j])) {
+                SDL_Log("%s: batch gives %a, scalar %a for (%a, %a)", f.name, out[j], scalar, a[j], b[j]);
+                return false;
+            }
+
+            f64 expected = f.reference(a[j], b[j]);
+            f64 error = fabs((f64)scalar - expected);
+            if (f.relative) error /= fabs(expected);
+            if (!(error <= max_error)) {
+                max_error = error;
+                worst_a = a[j];
+                worst_b = b[j];
+            }
+        }
+    }
+
+    bool ok = max_error < f.bound;
+    SDL_Log(
+        "%-10s max %s error %.3g (bound %.0e) at (%.9g, %.9g)%s",
+        f.name,
+        f.relative ? "relative" : "absolute",
+        max_error,
+        f.bound,
+        worst_a,
+        worst_b,
+        ok ? "" : "  EXCEEDS BOUND"
+    );
+    return ok;
+}
+
+static f64 seconds_since(u64 start) {
+    return (f64)(SDL_GetPerformanceCounter() - start) / (f64)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * @brief Repeats `f`, one pass over a chunk, until a run lasts long enough
+ * to time, and returns the fastest of 5 runs in nanoseconds per element.
+ */
+template <typename F> static f64 time_ns(F&& f) {
+    u32 calls = 1;
+    for (;;) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        if (seconds_since(start) >= FASTMATH_BENCH_MIN_SECONDS / 5) break;
+        calls *= 2;
+    }
+
+    f64 best = 1e30;
+    for (u32 run = 0; run < 5; run++) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        best = SDL_min(best, seconds_since(start) / calls);
+    }
+    return best * 1e9 / FASTMATH_BENCH_CHUNK;
+}
+
+/**
+ * @brief Times the libm loop, the scalar fast loop and the batch call on
+ * inputs from the function's domain. Both scalar loops call through the
+ * table's function pointers, so they pay the same call overhead.
+ */
+static void bench(const FastFunction& f) {
+    static f32 a[FASTMATH_BENCH_CHUNK];
+    static f32 b[FASTMATH_BENCH_CHUNK];
+    static f32 out[FASTMATH_BENCH_CHUNK];
+
+    // Even samples only: they are spread evenly over the domain, where the
+    // odd ones crowd towards zero and denormals, which no caller times
+    for (usize j = 0; j < FASTMATH_BENCH_CHUNK; j++) {
+        b[j] = 0.0f;
+        f.input(sample_hash(j) % (FASTMATH_BENCH_SAMPLES / 2) * 2, &a[j], &b[j]);
+    }
+
+    f64 libm_ns = time_ns([&] {
+        for (usize j = 0; j < FASTMATH_BENCH_CHUNK; j++) out[j] = f.libm(a[j], b[j]);
+    });
+    f64 scalar_ns = time_ns([&] {
+        for (usize j = 0; j < FASTMATH_BENCH_CHUNK; j++) out[j] = f.fast(a[j], b[j]);
+    });
+    f64 batch_ns = time_ns([&] {
+        f.fast_n(a, b, out, FASTMATH_BENCH_CHUNK);
+    });
+
+    SDL_Log(
+        "%-10s libm %6.2f ns, scalar %6.2f ns (%.1fx), batch %6.2f ns (%.1fx)",
+        f.name,
+        libm_ns,
+        scalar_ns,
+        libm_ns / scalar_ns,
+        batch_ns,
+        libm_ns / batch_ns
+    );
+
+    volatile f32 sink = out[0];
+    (void)sink;
+}
+
+int main() {
+    bool ok = true;
+    SDL_Log("Accuracy against double-precision libm, %u inputs each:", FASTMATH_BENCH_SAMPLES);
+    for (const FastFunction& f : functions) {
+        ok = check_accuracy(f) && ok;
+    }
+
+    SDL_Log("Per element, %d elements per pass:", FASTMATH_BENCH_CHUNK);
+    for (const FastFunction& f : functions) {
+        bench(f);
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
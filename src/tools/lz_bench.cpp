@@ -0,0 +1,217 @@
+// Measures the lz codec on real files: compression ratio, compression and
+// decompression speed, and how fast a load is as a plain read of the file
+// versus a read of its compressed stream plus decoding. Build and run from
+// the repository root:
+//
+//   zig c++ -std=c++23 -O2 -Isrc src/tools/lz_bench.cpp -o lz_bench -lSDL3
+//   ./lz_bench assets/fonts/dejavu.ttf assets/images/TEXTURE_ATLAS.png
+//
+// Cold loads drop both files from the page cache before each run, which
+// needs posix_fadvise; elsewhere they are reported warm only.
+#include "core/types.h"
+#include "core/utils.h"
+#include "core/arena.cpp"
+#include "core/assert.cpp"
+#include "core/virtual_memory.cpp"
+#include "core/file.cpp"
+#include "core/lz.cpp"
+#include <SDL3/SDL.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#define LZ_BENCH_COLD
+#endif
+
+// Timed runs of each measurement; the fastest is reported
+#define LZ_BENCH_RUNS 5
+// Warm measurements repeat until they have run at least this long
+#define LZ_BENCH_MIN_SECONDS 0.25
+// Stands in for a mapped GPU transfer buffer in the streaming decode
+#define LZ_BENCH_CHUNK_SIZE MB(1)
+#define LZ_BENCH_STREAM_PATH "lz_bench.lzb"
+
+static f64 seconds_since(u64 start) {
+    return (f64)(SDL_GetPerformanceCounter() - start) / (f64)SDL_GetPerformanceFrequency();
+}
+
+static f64 mb_per_second(usize bytes, f64 seconds) {
+    return seconds > 0.0 ? (f64)bytes / MB(1) / seconds : 0.0;
+}
+
+/**
+ * @brief Runs `f` in batches until a batch lasts LZ_BENCH_MIN_SECONDS and
+ * returns the fastest time per call over LZ_BENCH_RUNS batches.
+ */
+template <typename F> static f64 time_warm(F&& f) {
+    u32 calls = 1;
+    for (;;) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        if (seconds_since(start) >= LZ_BENCH_MIN_SECONDS / LZ_BENCH_RUNS) break;
+        calls *= 2;
+    }
+
+    f64 best = 1e30;
+    for (u32 run = 0; run < LZ_BENCH_RUNS; run++) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        best = SDL_min(best, seconds_since(start) / calls);
+    }
+    return best;
+}
+
+/**
+ * @brief Drops a file's pages from the page cache so the next read comes
+ * from the disk.
+ * @return False where the OS offers no way to do it.
+ */
+static bool evict_file(const char* path) {
+#if defined(LZ_BENCH_COLD)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    fdatasync(fd);
+    bool ok = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return ok;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+static bool read_whole(const char* path, u8* dst, usize size) {
+    SDL_IOStream* io = SDL_IOFromFile(path, "rb");
+    if (!io) return false;
+    bool ok = SDL_ReadIO(io, dst, size) == size;
+    SDL_CloseIO(io);
+    return ok;
+}
+
+/**
+ * @brief Times one load: the plain file read into `raw`, or the stream read
+ * into `stream` and decoded into `raw`.
+ * @return Seconds taken, or a negative value on failure.
+ */
+static f64 time_load(const char* path, usize raw_size, const char* stream_path, usize stream_size, u8* raw, u8* stream, bool cold) {
+    if (cold) evict_file(stream_path ? stream_path : path);
+
+    u64 start = SDL_GetPerformanceCounter();
+    if (!stream_path) {
+        if (!read_whole(path, raw, raw_size)) return -1.0;
+    } else if (!read_whole(stream_path, stream, stream_size) ||
+               !lz_decompress(stream, stream_size, raw, raw_size)) {
+        return -1.0;
+    }
+    return seconds_since(start);
+}
+
+/**
+ * @brief Benchmarks one file and prints its results.
+ * @return False if the file cannot be read or does not round-trip.
+ */
+static bool bench_file(Arena* arena, const char* path) {
+    ArenaTemp temp = arena->begin_temp();
+    defer {
+        arena->end_temp(temp);
+    };
+
+    FileView source;
+    if (!source.open(path) || source.size == 0) {
+        SDL_Log("%s: cannot read or empty", path);
+        return false;
+    }
+    usize raw_size = source.size;
+
+    usize bound = lz_compress_bound(raw_size);
+    u8* stream = (u8*)arena->push(bound, 64);
+    u8* raw = (u8*)arena->push(raw_size, 64);
+    u8* chunk = (u8*)arena->push(LZ_BENCH_CHUNK_SIZE, 64);
+    if (!stream || !raw || !chunk) {
+        SDL_Log("%s: out of memory", path);
+        return false;
+    }
+
+    usize stream_size = 0;
+    f64 compress_time = time_warm([&] {
+        stream_size = lz_compress(source.data, raw_size, stream, bound);
+    });
+    if (!lz_decompress(stream, stream_size, raw, raw_size) ||
+        SDL_memcmp(raw, source.data, raw_size) != 0) {
+        SDL_Log("%s: round trip failed", path);
+        return false;
+    }
+
+    f64 decompress_time = time_warm([&] {
+        lz_decompress(stream, stream_size, raw, raw_size);
+    });
+    f64 stream_time = time_warm([&] {
+        LzDecoder decoder;
+        decoder.begin(stream, stream_size);
+        while (decoder.decode(chunk, LZ_BENCH_CHUNK_SIZE) != 0) {
+        }
+    });
+    f64 memcpy_time = time_warm([&] {
+        SDL_memcpy(raw, source.data, raw_size);
+    });
+
+    SDL_Log("%s: %.2f MB -> %.2f MB (ratio %.2f)", path, (f64)raw_size / MB(1), (f64)stream_size / MB(1), (f64)raw_size / stream_size);
+    SDL_Log("  compress          %8.1f MB/s", mb_per_second(raw_size, compress_time));
+    SDL_Log("  decompress        %8.1f MB/s", mb_per_second(raw_size, decompress_time));
+    SDL_Log("  decode in %zu MB chunks %6.1f MB/s", LZ_BENCH_CHUNK_SIZE / MB(1), mb_per_second(raw_size, stream_time));
+    SDL_Log("  memcpy            %8.1f MB/s", mb_per_second(raw_size, memcpy_time));
+
+    SDL_IOStream* io = SDL_IOFromFile(LZ_BENCH_STREAM_PATH, "wb");
+    bool written = io && SDL_WriteIO(io, stream, stream_size) == stream_size;
+    if (io && !SDL_CloseIO(io)) written = false;
+    if (!written) {
+        SDL_Log("%s: cannot write %s", path, LZ_BENCH_STREAM_PATH);
+        return false;
+    }
+    defer {
+        SDL_RemovePath(LZ_BENCH_STREAM_PATH);
+    };
+
+    // Load speeds count the bytes the caller ends up with, so both are
+    // comparable whatever the ratio
+    bool can_evict = evict_file(path);
+    for (i32 cold = can_evict ? 1 : 0; cold >= 0; cold--) {
+        f64 plain = 1e30;
+        f64 packed = 1e30;
+        for (u32 run = 0; run < LZ_BENCH_RUNS; run++) {
+            f64 plain_run = time_load(path, raw_size, nullptr, 0, raw, stream, cold);
+            f64 packed_run = time_load(path, raw_size, LZ_BENCH_STREAM_PATH, stream_size, raw, stream, cold);
+            if (plain_run < 0.0 || packed_run < 0.0) {
+                SDL_Log("%s: load failed", path);
+                return false;
+            }
+            plain = SDL_min(plain, plain_run);
+            packed = SDL_min(packed, packed_run);
+        }
+        SDL_Log(
+            "  %s load: read %.1f MB/s, read + decompress %.1f MB/s",
+            cold ? "cold" : "warm",
+            mb_per_second(raw_size, plain),
+            mb_per_second(raw_size, packed)
+        );
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        SDL_Log("Usage: %s <file>...", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Arena arena(MB(64), true, ARENA_BACKEND_VIRTUAL);
+    defer {
+        arena.destroy();
+    };
+
+    bool ok = true;
+    for (i32 i = 1; i < argc; i++) {
+        ok = bench_file(&arena, argv[i]) && ok;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,455 @@
+// Checks that the SIMD mat4x4 paths in math3d.h give bit-identical results
+// to plain scalar loops, on random matrices and on NaN, infinity, signed
+// zero and denormal entries, and to the `if consteval` paths on inputs
+// evaluated at compile time, then times them against the scalar loops.
+// inverted() is checked separately, within a tolerance: M * M^-1 must be
+// close to identity on well-conditioned matrices, and singular matrices
+// must give the zero matrix.
+// Build and run from the repository root:
+//
+//   zig c++ -std=c++23 -O2 -ffp-contract=off -Isrc src/tools/math3d_bench.cpp -o math3d_bench -lSDL3
+//   ./math3d_bench
+//
+// -ffp-contract=off keeps the compiler from fusing the reference loops into
+// FMAs, which round differently. Exits with failure on the first mismatch.
+#include "core/types.h"
+#include "core/utils.h"
+#include "core/math3d.h"
+#include <SDL3/SDL.h>
+
+#define MATH3D_BENCH_RANDOM_CASES 200000
+// Matrices per timed pass; small enough to stay in L1
+#define MATH3D_BENCH_BATCH 256
+#define MATH3D_BENCH_MIN_SECONDS 0.25
+#define MATH3D_BENCH_INVERSE_CASES 100000
+// Largest entry of M * M^-1 - I allowed. The random matrices are strictly
+// diagonally dominant (condition number below about 10), so this is a few
+// dozen float epsilons (1.19e-7) per entry.
+#define MATH3D_BENCH_INVERSE_TOLERANCE 4e-6f
+
+struct Rng {
+    u64 state;
+
+    u64 next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    // Uniform in [-range, range)
+    f32 uniform(f32 range) {
+        return ((f32)(next() >> 40) / (f32)(1 << 24) * 2.0f - 1.0f) * range;
+    }
+    // Any bit pattern, so NaN, infinity and denormals all turn up
+    f32 bits() {
+        u32 word = (u32)next();
+        f32 value;
+        SDL_memcpy(&value, &word, sizeof(value));
+        return value;
+    }
+};
+
+static const f32 special_values[] = {
+    0.0f, -0.0f, 1.0f, -1.0f, INFINITY, -INFINITY, NAN, -NAN,
+    1e-40f, -1e-40f, 1.17549435e-38f, 3.40282347e+38f, -3.40282347e+38f,
+};
+
+// Reference: the scalar loops math3d used before the SIMD paths
+static mat4x4 reference_mul(const mat4x4& a, const mat4x4& b) {
+    mat4x4 result(0);
+    for (usize i = 0; i < 4; i++) {
+        for (usize j = 0; j < 4; j++) {
+            for (usize k = 0; k < 4; k++) {
+                result(i, j) += a(i, k) * b(k, j);
+            }
+        }
+    }
+    return result;
+}
+
+static vec4 reference_mul(const mat4x4& m, const vec4& v) {
+    vec4 result;
+    for (usize i = 0; i < 4; i++) {
+        result[i] = m(i, 0) * v.x + m(i, 1) * v.y + m(i, 2) * v.z + m(i, 3) * v.w;
+    }
+    return result;
+}
+
+static mat4x4 reference_transposed(const mat4x4& m) {
+    mat4x4 result(0);
+    for (usize i = 0; i < 4; i++) {
+        for (usize j = 0; j < 4; j++) {
+            result(i, j) = m(j, i);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Compares two floats bit for bit. Any two NaNs match: which
+ * operand's payload survives an add depends on operand order, which the
+ * compiler may swap in the reference loops.
+ */
+static bool same_bits(f32 a, f32 b) {
+    if (a != a && b != b) return true;
+    u32 bits_a, bits_b;
+    SDL_memcpy(&bits_a, &a, sizeof(a));
+    SDL_memcpy(&bits_b, &b, sizeof(b));
+    return bits_a == bits_b;
+}
+
+static bool same_bits(const vec4& a, const vec4& b) {
+    for (usize i = 0; i < 4; i++) {
+        if (!same_bits(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+static bool same_bits(const mat4x4& a, const mat4x4& b) {
+    for (usize i = 0; i < 4; i++) {
+        if (!same_bits(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+static void log_matrix(const char* label, const mat4x4& m) {
+    SDL_Log("  %s:", label);
+    for (usize i = 0; i < 4; i++) {
+        SDL_Log("    %a %a %a %a", m(i, 0), m(i, 1), m(i, 2), m(i, 3));
+    }
+}
+
+/**
+ * @brief Runs every SIMD path on one pair of matrices and a vector, and
+ * checks each result against the reference.
+ * @return False on the first mismatch, after logging it.
+ */
+static bool check_case(const char* kind, u32 index, const mat4x4& a, const mat4x4& b, const vec4& v) {
+    const char* failed = nullptr;
+    if (!same_bits(a * b, reference_mul(a, b))) {
+        failed = "mat * mat";
+    } else if (!same_bits(a * v, reference_mul(a, v))) {
+        failed = "mat * vec";
+    } else if (!same_bits(a.transposed(), reference_transposed(a))) {
+        failed = "transposed";
+    }
+    if (!failed) return true;
+
+    SDL_Log("%s differs from the scalar reference (%s case %u)", failed, kind, index);
+    log_matrix("a", a);
+    log_matrix("b", b);
+    SDL_Log("  v: %a %a %a %a", v.x, v.y, v.z, v.w);
+    return false;
+}
+
+/**
+ * @brief Checks random matrices, matrices of arbitrary bit patterns, and
+ * every special value placed in every entry.
+ */
+static bool check_bit_exact() {
+    Rng rng{0x9E3779B97F4A7C15ull};
+
+    for (u32 n = 0; n < MATH3D_BENCH_RANDOM_CASES; n++) {
+        bool any_bits = n % 4 == 3;
+        mat4x4 a(0), b(0);
+        vec4 v;
+        for (usize i = 0; i < 16; i++) {
+            a(i / 4, i % 4) = any_bits ? rng.bits() : rng.uniform(1000.0f);
+            b(i / 4, i % 4) = any_bits ? rng.bits() : rng.uniform(1000.0f);
+        }
+        for (usize i = 0; i < 4; i++) {
+            v[i] = any_bits ? rng.bits() : rng.uniform(1000.0f);
+        }
+        if (!check_case(any_bits ? "bit pattern" : "random", n, a, b, v)) return false;
+    }
+
+    u32 index = 0;
+    for (f32 special : special_values) {
+        for (usize entry = 0; entry < 16; entry++, index++) {
+            mat4x4 a(0), b(0);
+            for (usize i = 0; i < 16; i++) {
+                a(i / 4, i % 4) = rng.uniform(2.0f);
+                b(i / 4, i % 4) = rng.uniform(2.0f);
+            }
+            a(entry / 4, entry % 4) = special;
+            b(entry % 4, entry / 4) = special;
+            vec4 v(rng.uniform(2.0f), rng.uniform(2.0f), rng.uniform(2.0f), rng.uniform(2.0f));
+            v[entry % 4] = special;
+            if (!check_case("special value", index, a, b, v)) return false;
+        }
+    }
+
+    SDL_Log(
+        "Bit-exact: %u random and %u special-value cases match the scalar loops",
+        MATH3D_BENCH_RANDOM_CASES,
+        index
+    );
+    return true;
+}
+
+// Inputs with fractions that round, a signed zero and a denormal, so the
+// compile-time and run-time paths have rounding to disagree on
+static constexpr mat4x4 constexpr_matrix(f32 seed) {
+    mat4x4 m(0);
+    for (usize i = 0; i < 16; i++) {
+        m(i / 4, i % 4) = seed / (f32)(i + 3) - (f32)i * 0.37f;
+    }
+    m(1, 2) = -0.0f;
+    m(2, 1) = 1e-40f;
+    return m;
+}
+
+static constexpr mat4x4 ct_a = constexpr_matrix(1.0f);
+static constexpr mat4x4 ct_b = constexpr_matrix(-7.5f);
+static constexpr vec4 ct_v = vec4(0.1f, -2.0f / 3.0f, 1e-40f, -0.0f);
+
+// Evaluated by the compiler through the scalar `if consteval` branches
+static constexpr mat4x4 ct_ab = ct_a * ct_b;
+static constexpr mat4x4 ct_aba = ct_a * ct_b * ct_a;
+static constexpr vec4 ct_av = ct_a * ct_v;
+static constexpr vec4 ct_abv = ct_a * ct_b * ct_v;
+static constexpr mat4x4 ct_at = ct_a.transposed();
+
+/**
+ * @brief Recomputes the compile-time constants at run time and checks the
+ * SIMD results match them bit for bit. The inputs are read through a
+ * volatile pointer so the compiler cannot fold the products itself.
+ */
+static bool check_constexpr() {
+    const mat4x4* volatile a_source = &ct_a;
+    const mat4x4* volatile b_source = &ct_b;
+    const vec4* volatile v_source = &ct_v;
+    mat4x4 a = *a_source;
+    mat4x4 b = *b_source;
+    vec4 v = *v_source;
+
+    const char* failed = nullptr;
+    if (!same_bits(a * b, ct_ab)) {
+        failed = "mat * mat";
+    } else if (!same_bits(a * b * a, ct_aba)) {
+        failed = "mat * mat * mat";
+    } else if (!same_bits(a * v, ct_av)) {
+        failed = "mat * vec";
+    } else if (!same_bits(a * b * v, ct_abv)) {
+        failed = "mat * mat * vec";
+    } else if (!same_bits(a.transposed(), ct_at)) {
+        failed = "transposed";
+    }
+    if (failed) {
+        SDL_Log("%s differs between compile time and run time", failed);
+        return false;
+    }
+
+    SDL_Log("Constexpr: compile-time results match the run-time paths");
+    return true;
+}
+
+/**
+ * @brief Largest absolute difference between an entry of `m` and the
+ * identity matrix.
+ */
+static f32 identity_error(const mat4x4& m) {
+    f32 error = 0.0f;
+    for (usize i = 0; i < 4; i++) {
+        for (usize j = 0; j < 4; j++) {
+            f32 expected = i == j ? 1.0f : 0.0f;
+            error = SDL_max(error, SDL_fabsf(m(i, j) - expected));
+        }
+    }
+    return error;
+}
+
+/**
+ * @brief Checks that M * M^-1 and M^-1 * M are within
+ * MATH3D_BENCH_INVERSE_TOLERANCE of identity on random well-conditioned
+ * matrices, and that singular matrices invert to all zeros.
+ */
+static bool check_inverse() {
+    Rng rng{0xA0761D6478BD642Full};
+
+    f32 worst = 0.0f;
+    for (u32 n = 0; n < MATH3D_BENCH_INVERSE_CASES; n++) {
+        // Off-diagonal entries in [-1, 1) and a diagonal of magnitude 4 to
+        // 8 keep every row strictly diagonally dominant
+        mat4x4 m(0);
+        for (usize i = 0; i < 16; i++) {
+            m(i / 4, i % 4) = rng.uniform(1.0f);
+        }
+        for (usize i = 0; i < 4; i++) {
+            f32 diagonal = 6.0f + rng.uniform(2.0f);
+            m(i, i) = rng.next() & 1 ? diagonal : -diagonal;
+        }
+        // Scaled so inputs are not all of one magnitude
+        f32 scale = SDL_powf(2.0f, rng.uniform(20.0f));
+        for (usize i = 0; i < 16; i++) {
+            m(i / 4, i % 4) *= scale;
+        }
+
+        mat4x4 inverse = m.inverted();
+        f32 error = SDL_max(identity_error(m * inverse), identity_error(inverse * m));
+        worst = SDL_max(worst, error);
+        if (!(error <= MATH3D_BENCH_INVERSE_TOLERANCE)) {
+            SDL_Log("M * M^-1 is %g away from identity (case %u)", error, n);
+            log_matrix("m", m);
+            log_matrix("inverted", inverse);
+            return false;
+        }
+    }
+
+    // Zero rows and columns, and rows copied or doubled from another row,
+    // make the determinant exactly zero
+    u32 singular_cases = 0;
+    for (u32 kind = 0; kind < 4; kind++) {
+        for (usize k = 0; k < 4; k++, singular_cases++) {
+            mat4x4 m(0);
+            for (usize i = 0; i < 16; i++) {
+                m(i / 4, i % 4) = rng.uniform(10.0f);
+            }
+            usize other = k ^ 1;
+            for (usize j = 0; j < 4; j++) {
+                switch (kind) {
+                    case 0: m(k, j) = 0.0f; break;
+                    case 1: m(j, k) = 0.0f; break;
+                    case 2: m(k, j) = m(other, j); break;
+                    case 3: m(k, j) = m(other, j) * 2.0f; break;
+                }
+            }
+
+            mat4x4 inverse = m.inverted();
+            if (!same_bits(inverse, mat4x4(0))) {
+                SDL_Log("Singular matrix (kind %u, row or column %zu) did not invert to zero", kind, k);
+                log_matrix("m", m);
+                log_matrix("inverted", inverse);
+                return false;
+            }
+        }
+    }
+
+    SDL_Log(
+        "Inverse: %u matrices within %g of identity (worst %g), %u singular matrices give zero",
+        MATH3D_BENCH_INVERSE_CASES,
+        MATH3D_BENCH_INVERSE_TOLERANCE,
+        worst,
+        singular_cases
+    );
+    return true;
+}
+
+static f64 seconds_since(u64 start) {
+    return (f64)(SDL_GetPerformanceCounter() - start) / (f64)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * @brief Repeats `f`, one pass over the batch, until a run lasts long
+ * enough to time, and returns the fastest of 5 runs in nanoseconds per
+ * element.
+ */
+template <typename F> static f64 time_ns(F&& f) {
+    u32 calls = 1;
+    for (;;) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        if (seconds_since(start) >= MATH3D_BENCH_MIN_SECONDS / 5) break;
+        calls *= 2;
+    }
+
+    f64 best = 1e30;
+    for (u32 run = 0; run < 5; run++) {
+        u64 start = SDL_GetPerformanceCounter();
+        for (u32 i = 0; i < calls; i++) f();
+        best = SDL_min(best, seconds_since(start) / calls);
+    }
+    return best * 1e9 / MATH3D_BENCH_BATCH;
+}
+
+static void report(const char* name, f64 simd_ns, f64 scalar_ns) {
+    SDL_Log("  %-22s %6.2f ns vs %6.2f ns scalar (%.2fx)", name, simd_ns, scalar_ns, scalar_ns / simd_ns);
+}
+
+/**
+ * @brief Times each path over a batch, both independent (throughput) and
+ * as a chain where each result feeds the next (latency).
+ */
+static void bench() {
+    static mat4x4 a[MATH3D_BENCH_BATCH];
+    static mat4x4 b[MATH3D_BENCH_BATCH];
+    static mat4x4 out[MATH3D_BENCH_BATCH];
+    static vec4 v[MATH3D_BENCH_BATCH];
+    static vec4 out_v[MATH3D_BENCH_BATCH];
+
+    Rng rng{12345};
+    for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) {
+        for (usize i = 0; i < 16; i++) {
+            a[n](i / 4, i % 4) = rng.uniform(1.0f);
+            b[n](i / 4, i % 4) = rng.uniform(1.0f);
+        }
+        v[n] = vec4(rng.uniform(1.0f), rng.uniform(1.0f), rng.uniform(1.0f), 1.0f);
+    }
+
+    SDL_Log("Per operation, batch of %d:", MATH3D_BENCH_BATCH);
+    report(
+        "mat * mat",
+        time_ns([&] {
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) out[n] = a[n] * b[n];
+        }),
+        time_ns([&] {
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) out[n] = reference_mul(a[n], b[n]);
+        })
+    );
+    report(
+        "mat * mat, chained",
+        time_ns([&] {
+            mat4x4 m = a[0];
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) m = m * b[n];
+            out[0] = m;
+        }),
+        time_ns([&] {
+            mat4x4 m = a[0];
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) m = reference_mul(m, b[n]);
+            out[0] = m;
+        })
+    );
+    report(
+        "mat * vec",
+        time_ns([&] {
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) out_v[n] = a[0] * v[n];
+        }),
+        time_ns([&] {
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) out_v[n] = reference_mul(a[0], v[n]);
+        })
+    );
+    report(
+        "mat * vec, chained",
+        time_ns([&] {
+            vec4 p = v[0];
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) p = a[n] * p;
+            out_v[0] = p;
+        }),
+        time_ns([&] {
+            vec4 p = v[0];
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) p = reference_mul(a[n], p);
+            out_v[0] = p;
+        })
+    );
+    report(
+        "transposed",
+        time_ns([&] {
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) out[n] = a[n].transposed();
+        }),
+        time_ns([&] {
+            for (usize n = 0; n < MATH3D_BENCH_BATCH; n++) out[n] = reference_transposed(a[n]);
+        })
+    );
+
+    // Keeps the stores above from being discarded
+    volatile f32 sink = out[0](0, 0) + out_v[0].x;
+    (void)sink;
+}
+
+int main() {
+    if (!check_constexpr() || !check_bit_exact() || !check_inverse()) {
+        return EXIT_FAILURE;
+    }
+    bench();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+// Offline packer for .pak archives. Packs every file under a directory,
+// except shader sources, so the game maps one archive at startup instead of
+// opening loose files. Files that compress well are stored compressed:
+//
+//   pak_builder <assets_dir> <out.pak>
+#include "core/types.h"
+#include "core/utils.h"
+#include "core/arena.cpp"
+#include "core/assert.cpp"
+#include "core/virtual_memory.cpp"
+#include "core/hash_map.cpp"
+#include "core/file.cpp"
+#include "core/lz.cpp"
+#include "core/pak.cpp"
+#include <SDL3/SDL.h>
+
+// Directories under the assets root that only the build needs
+static const char* const skipped_prefixes[] = {
+    "shaders/source/",
+};
+
+static bool is_skipped(const char* name) {
+    for (usize i = 0; i < SDL_arraysize(skipped_prefixes); i++) {
+        if (SDL_strncmp(name, skipped_prefixes[i], SDL_strlen(skipped_prefixes[i])) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        SDL_Log("Usage: %s <assets_dir> <out.pak>", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char* root = argv[1];
+    const char* out_path = argv[2];
+
+    Arena arena(MB(64), true, ARENA_BACKEND_VIRTUAL);
+    defer {
+        arena.destroy();
+    };
+
+    i32 found = 0;
+    char** names = SDL_GlobDirectory(root, nullptr, 0, &found);
+    if (!names) {
+        SDL_Log("Failed to list '%s': %s", root, SDL_GetError());
+        return EXIT_FAILURE;
+    }
+    defer {
+        SDL_free(names);
+    };
+
+    PakInput* inputs = arena.push_array<PakInput>(SDL_max(found, 1));
+    u32 input_count = 0;
+    u64 total_size = 0;
+    for (i32 i = 0; i < found; i++) {
+        // Entry names always use '/', whatever the host separator is
+        for (char* c = names[i]; *c; c++) {
+            if (*c == '\\') *c = '/';
+        }
+        if (is_skipped(names[i])) continue;
+
+        usize path_size = SDL_strlen(root) + SDL_strlen(names[i]) + 2;
+        char* path = (char*)arena.push(path_size, 1);
+        SDL_snprintf(path, path_size, "%s/%s", root, names[i]);
+
+        SDL_PathInfo info{};
+        if (!SDL_GetPathInfo(path, &info) || info.type != SDL_PATHTYPE_FILE) continue;
+
+        inputs[input_count++] = {names[i], path};
+        total_size += info.size;
+    }
+
+    if (!pak_write(&arena, out_path, inputs, input_count)) {
+        return EXIT_FAILURE;
+    }
+
+    SDL_Log(
+        "Packed %u files (%.2f MB) into %s (%.2f MB)",
+        input_count,
+        (f64)total_size / MB(1),
+        out_path,
+        (f64)file_get_size(out_path) / MB(1)
+    );
+    return EXIT_SUCCESS;
+}